@@ -0,0 +1,181 @@
+#include "../../build/include/image.hpp"
+#include "../../build/include/ndjson.hpp"
+#include "../../build/include/parser.hpp"
+#include "../../build/include/serializer.hpp"
+
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "corpus.hpp"
+
+// every heap allocation of the process goes through here, so the library
+// does not need any hook to be measured
+static std::atomic<std::uint64_t> allocations{0};
+static std::atomic<std::uint64_t> allocatedBytes{0};
+
+auto operator new(std::size_t size) -> void* {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (const auto ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+auto operator delete(void* ptr) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept -> void {
+    std::free(ptr);
+}
+
+// keeps the optimizer from dropping the measured work
+static volatile std::size_t sink{0};
+
+auto peak_rss_kb() noexcept -> long {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// sums every scalar and the length of every string, touching the whole tree
+auto walk(const json::node& value) -> std::size_t {
+    switch (value.tag()) {
+        case json::node_tag::JsonNull:
+            return 1;
+        case json::node_tag::JsonBool:
+            return value.value<bool>();
+        case json::node_tag::JsonInt:
+        case json::node_tag::JsonFloat:
+            return static_cast<std::size_t>(value.value<double>());
+        case json::node_tag::JsonString:
+            return value.string().size();
+        case json::node_tag::JsonArray: {
+            std::size_t retval{0};
+            for (const auto& item : value.items()) retval += walk(item);
+            return retval;
+        }
+        case json::node_tag::JsonObject: {
+            std::size_t retval{0};
+            for (const auto& [key, field] : value.fields())
+                retval += key.view().size() + walk(field);
+            return retval;
+        }
+    }
+    return 0;
+}
+
+// runs `run` until `seconds` elapsed, after one warm up round, and
+// prints a json line per measurement
+auto measure(std::string_view corpus, std::string_view operation,
+             std::size_t bytes, std::size_t documents, double seconds,
+             const std::function<void()>& run) -> void {
+    using clock = std::chrono::steady_clock;
+
+    run();
+    const auto startAllocations{allocations.load()};
+    const auto startBytes{allocatedBytes.load()};
+    const auto start{clock::now()};
+
+    std::uint64_t iterations{0};
+    std::chrono::duration<double> elapsed{};
+    do {
+        run();
+        iterations++;
+        elapsed = clock::now() - start;
+    } while (elapsed.count() < seconds);
+
+    const auto totalDocuments{static_cast<double>(iterations * documents)};
+    std::cout << std::format(
+                     R"({{"corpus":"{}","operation":"{}","bytes":{},)"
+                     R"("documents":{},"iterations":{},"seconds":{:.3f},)"
+                     R"("mb_per_s":{:.2f},"documents_per_s":{:.0f},)"
+                     R"("allocations_per_document":{:.2f},)"
+                     R"("allocated_bytes_per_document":{:.0f},)"
+                     R"("peak_rss_kb":{}}})",
+                     corpus, operation, bytes, documents, iterations,
+                     elapsed.count(),
+                     iterations * bytes / elapsed.count() / (1 << 20),
+                     totalDocuments / elapsed.count(),
+                     (allocations.load() - startAllocations) / totalDocuments,
+                     (allocatedBytes.load() - startBytes) / totalDocuments,
+                     peak_rss_kb())
+              << std::endl;
+}
+
+auto bench_document(std::string_view name, const std::string& content,
+                    double seconds) -> void {
+    measure(name, "parse", content.size(), 1, seconds,
+            [&] { sink = sink + json::deserialize(content).fields().size(); });
+
+    json::parser parser{};
+    measure(name, "parse_reused", content.size(), 1, seconds,
+            [&] { sink = sink + parser.parse(content).fields().size(); });
+
+    const auto root{json::deserialize(content)};
+    measure(name, "access", content.size(), 1, seconds,
+            [&] { sink = sink + walk(root); });
+
+    // the image replaces the parse at startup
+    const auto bytes{json::serialize_image(root)};
+    measure(name, "image_open", content.size(), 1, seconds, [&] {
+        sink = sink + json::image{bytes}.root().size();
+    });
+
+    std::string buffer{};
+    measure(name, "serialize", content.size(), 1, seconds, [&] {
+        buffer.clear();
+        json::serialize(root, buffer);
+        sink = sink + buffer.size();
+    });
+}
+
+auto bench_lines(std::string_view name, const std::string& content,
+                 std::size_t lines, double seconds) -> void {
+    measure(name, "parse", content.size(), lines, seconds, [&] {
+        sink = sink + json::deserialize_ndjson(content, {.threads = 1}).size();
+    });
+
+    measure(name, "parse_threaded", content.size(), lines, seconds,
+            [&] { sink = sink + json::deserialize_ndjson(content).size(); });
+
+    json::parser parser{};
+    measure(name, "parse_reused", content.size(), lines, seconds, [&] {
+        for (std::string_view rest{content}; !rest.empty();) {
+            const auto end{rest.find('\n')};
+            sink = sink + parser.parse(rest.substr(0, end)).fields().size();
+            rest.remove_prefix(end + 1);
+        }
+    });
+}
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 2) throw std::invalid_argument("unexpected parameters provided");
+    // minimal duration of every measurement, in seconds
+    const auto seconds{argc == 2 ? std::stod(argv[1]) : 1.0};
+
+    const auto twitter{corpus::twitter(600)};
+    const auto citm{corpus::citm(2000)};
+    const auto canada{corpus::canada(100'000)};
+    constexpr std::size_t lines{20'000};
+    const auto logs{corpus::logs(lines)};
+
+    bench_document("twitter", twitter, seconds);
+    bench_document("citm", citm, seconds);
+    bench_document("canada", canada, seconds);
+    bench_lines("logs", logs, lines, seconds);
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+// documents shaped like the usual json benchmark files, generated from a
+// fixed seed so every run and every machine parses the same bytes; random
+// values are drawn into locals first, the evaluation order of function
+// arguments is unspecified
+namespace corpus {
+// xorshift, unlike the standard distributions its output is portable
+class random final {
+   public:
+    explicit random(std::uint64_t seed) noexcept : _state(seed) {}
+
+    auto next() noexcept -> std::uint64_t {
+        _state ^= _state << 13;
+        _state ^= _state >> 7;
+        _state ^= _state << 17;
+        return _state;
+    }
+
+    auto below(std::uint64_t bound) noexcept -> std::uint64_t {
+        return next() % bound;
+    }
+
+    auto real(double low, double high) noexcept -> double {
+        return low + (high - low) * static_cast<double>(next() >> 11) /
+                         static_cast<double>(std::uint64_t{1} << 53);
+    }
+
+    auto word() -> std::string_view {
+        constexpr std::string_view words[]{
+            "lorem", "ipsum",  "dolor", "sit",     "amet",  "json",
+            "parse", "stream", "café",  "naïve",   "🚀",    "東京",
+            "value", "node",   "tape",  "benchmark", "data", "weather"};
+        return words[below(std::size(words))];
+    }
+
+    auto sentence(std::size_t words) -> std::string {
+        std::string retval{};
+        for (std::size_t i{0}; i < words; i++) {
+            if (i != 0) retval += ' ';
+            retval += word();
+        }
+        return retval;
+    }
+
+   private:
+    std::uint64_t _state;
+};
+
+// search results: deep objects, long strings with escapes, 64 bits ids
+[[nodiscard]] inline auto twitter(std::size_t statuses) -> std::string {
+    random rng{0x7717e5};
+    std::string out{R"({"statuses":[)"};
+    for (std::size_t i{0}; i < statuses; i++) {
+        const auto id{std::uint64_t{505874924095815681} + rng.below(1 << 30)};
+        const auto userId{rng.below(std::uint64_t{1} << 40)};
+        const auto text{rng.sentence(12)};
+        const auto quoted{rng.word()};
+        const auto name{rng.sentence(2)};
+        const auto location{rng.sentence(1)};
+        const auto description{rng.sentence(20)};
+        const auto followers{rng.below(10000)};
+        const auto friends{rng.below(2000)};
+        const auto listed{rng.below(50)};
+        const auto favourites{rng.below(100000)};
+        const auto retweets{rng.below(100)};
+        const auto favorites{rng.below(500)};
+        const auto mention{rng.sentence(2)};
+        if (i != 0) out += ',';
+        out += std::format(
+            R"({{"metadata":{{"result_type":"recent","iso_language_code":"ja"}},)"
+            R"("created_at":"Sun Aug 31 00:29:15 +0000 2014","id":{},)"
+            R"("id_str":"{}","text":"@aym0566x \n\n{} \"{}\" あい",)"
+            R"("source":"<a href=\"http://twitter.com/download/iphone\">iPhone</a>",)"
+            R"("truncated":false,"in_reply_to_status_id":null,)"
+            R"("user":{{"id":{},"id_str":"{}","name":"{}","screen_name":"user_{}",)"
+            R"("location":"{}","description":"{}","url":null,)"
+            R"("followers_count":{},"friends_count":{},"listed_count":{},)"
+            R"("created_at":"Fri Mar 29 13:12:03 +0000 2013",)"
+            R"("favourites_count":{},"utc_offset":32400,"verified":false,)"
+            R"("profile_background_color":"C0DEED","default_profile":true}},)"
+            R"("geo":null,"coordinates":null,"retweet_count":{},)"
+            R"("favorite_count":{},"entities":{{"hashtags":[],"symbols":[],)"
+            R"("urls":[],"user_mentions":[{{"screen_name":"aym0566x",)"
+            R"("name":"{}","id":{},"id_str":"{}","indices":[0,9]}}]}},)"
+            R"("favorited":false,"retweeted":false,"lang":"ja"}})",
+            id, id, text, quoted, userId, userId, name, i, location,
+            description, followers, friends, listed, favourites, retweets,
+            favorites, mention, userId, userId);
+    }
+    out += std::format(
+        R"(],"search_metadata":{{"completed_in":0.087,"max_id":{},)"
+        R"("query":"%E4%B8%80","refresh_url":"?since_id=1&q=%E4%B8%80",)"
+        R"("count":{},"since_id":0}}}})",
+        std::uint64_t{505874924095815681}, statuses);
+    return out;
+}
+
+// event catalog: integer heavy, objects keyed by numeric ids, many nulls
+[[nodiscard]] inline auto citm(std::size_t performances) -> std::string {
+    random rng{0xc17e};
+    std::string out{R"({"areaNames":{)"};
+    for (std::size_t i{0}; i < 64; i++) {
+        const auto name{rng.sentence(3)};
+        out += std::format(R"({}"{}":"{}")", i == 0 ? "" : ",", 205705993 + i,
+                           name);
+    }
+
+    out += R"(},"events":{)";
+    for (std::size_t i{0}; i < performances / 4 + 1; i++) {
+        const auto id{138586341 + i};
+        const auto name{rng.sentence(4)};
+        const auto subtopic{337184269 + rng.below(100)};
+        const auto topic{324846099 + rng.below(100)};
+        out += std::format(
+            R"({}"{}":{{"description":null,"id":{},"logo":null,"name":"{}",)"
+            R"("subTitle":null,"subjectCode":null,"subtopicIds":[{},{}],)"
+            R"("topicIds":[{},{}]}})",
+            i == 0 ? "" : ",", id, id, name, subtopic, subtopic + 14, topic,
+            topic + 1);
+    }
+
+    out += R"(},"performances":[)";
+    for (std::size_t i{0}; i < performances; i++) {
+        out += std::format(
+            R"({}{{"eventId":{},"id":{},"logo":null,"name":null,"prices":[)",
+            i == 0 ? "" : ",", 138586341 + rng.below(performances / 4 + 1),
+            339887544 + i);
+        for (std::size_t p{0}, prices = 2 + rng.below(6); p < prices; p++) {
+            const auto amount{10000 + rng.below(90000) * 10};
+            const auto category{338937295 + rng.below(20)};
+            out += std::format(
+                R"({}{{"amount":{},"audienceSubCategoryId":337100890,)"
+                R"("seatCategoryId":{}}})",
+                p == 0 ? "" : ",", amount, category);
+        }
+
+        out += R"(],"seatCategories":[)";
+        for (std::size_t c{0}, categories = 1 + rng.below(4); c < categories;
+             c++) {
+            out += std::format(R"({}{{"areas":[)", c == 0 ? "" : ",");
+            for (std::size_t a{0}, areas = 1 + rng.below(8); a < areas; a++)
+                out += std::format(R"({}{{"areaId":{},"blockIds":[]}})",
+                                   a == 0 ? "" : ",",
+                                   205705993 + rng.below(64));
+            out += std::format(R"(],"seatCategoryId":{}}})",
+                               338937295 + rng.below(20));
+        }
+        out += std::format(
+            R"(],"seatMapImage":null,"start":{},"venueCode":"PLEYEL_PLEYEL"}})",
+            std::uint64_t{1372701600000} + rng.below(1'000'000'000));
+    }
+    out += R"(],"venueNames":{"PLEYEL_PLEYEL":"Salle Pleyel"}})";
+    return out;
+}
+
+// geographic outlines: almost only arrays of full precision doubles
+[[nodiscard]] inline auto canada(std::size_t points) -> std::string {
+    random rng{0xca0ada};
+    std::string out{
+        R"({"type":"FeatureCollection","features":[{"type":"Feature",)"
+        R"("properties":{"name":"Canada"},"geometry":{"type":"Polygon",)"
+        R"("coordinates":[)"};
+    for (std::size_t i{0}; i < points;) {
+        out += i == 0 ? "[" : ",[";
+        const auto ring{16 + rng.below(512)};
+        for (std::size_t j{0}; j < ring && i < points; j++, i++) {
+            const auto longitude{rng.real(-141.0, -52.6)};
+            const auto latitude{rng.real(41.7, 83.1)};
+            out += std::format("{}[{:.15f},{:.15f}]", j == 0 ? "" : ",",
+                               longitude, latitude);
+        }
+        out += ']';
+    }
+    out += "]}}]}";
+    return out;
+}
+
+// newline delimited service logs
+[[nodiscard]] inline auto logs(std::size_t lines) -> std::string {
+    constexpr std::string_view levels[]{"debug", "info", "warn", "error"};
+    constexpr std::string_view methods[]{"GET", "POST", "PUT", "DELETE"};
+
+    random rng{0x109};
+    std::string out{};
+    for (std::size_t i{0}; i < lines; i++) {
+        const auto day{1 + rng.below(28)};
+        const auto hour{rng.below(24)};
+        const auto minute{rng.below(60)};
+        const auto second{rng.below(60)};
+        const auto millis{rng.below(1000)};
+        const auto level{levels[rng.below(4)]};
+        const auto service{rng.below(8)};
+        const auto method{methods[rng.below(4)]};
+        const auto item{rng.below(1'000'000)};
+        const auto status{rng.below(5) == 0 ? 500 : 200};
+        const auto latency{rng.real(0.1, 900.0)};
+        const auto bytes{rng.below(1 << 20)};
+        const auto user{rng.below(std::uint64_t{1} << 48)};
+        const auto role{rng.word()};
+        const auto message{rng.sentence(8)};
+        out += std::format(
+            R"({{"ts":"2024-03-{:02}T{:02}:{:02}:{:02}.{:03}Z","level":"{}",)"
+            R"("service":"api-{}","method":"{}","path":"/v1/items/{}",)"
+            R"("status":{},"latency_ms":{:.3f},"bytes":{},)"
+            R"("user":{{"id":{},"roles":["reader","{}"]}},"msg":"{}"}})"
+            "\n",
+            day, hour, minute, second, millis, level, service, method, item,
+            status, latency, bytes, user, role, message);
+    }
+    return out;
+}
+}  // namespace corpus
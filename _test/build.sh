@@ -11,7 +11,7 @@ function do_build() {
         filename="$(basename $file)"
         filename="${filename%.*}"
         echo "[?] info: building file: $file"
-        g++ -Wall -Wextra -std=c++23 -$OPT_LEVEL -o build/$filename $file ../build/json.a
+        g++ -Wall -Wextra -std=c++23 $CXXFLAGS -pthread -$OPT_LEVEL -o build/$filename $file ../build/libjson.a
     done
 }
 
@@ -0,0 +1,87 @@
+#include "../../build/include/arena.hpp"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        json::arena arena{};
+        for (const auto alignment : {1u, 2u, 8u, 16u, 64u}) {
+            const auto ptr = arena.allocate(3, alignment);
+            if (reinterpret_cast<std::uintptr_t>(ptr) % alignment != 0)
+                return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        json::arena arena{256};
+        for (auto i = 0; i < 100; i++) const auto _ = arena.allocate(32, 8);
+        const auto capacity = arena.capacity();
+        if (arena.used() != 100 * 32) return TEST_ERROR();
+
+        arena.reset();
+        if (arena.used() != 0) return TEST_ERROR();
+        for (auto i = 0; i < 100; i++) const auto _ = arena.allocate(32, 8);
+        if (arena.capacity() != capacity) return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        json::arena arena{256};
+        const auto ptr = static_cast<char*>(arena.allocate(4096, 16));
+        std::memset(ptr, 0, 4096);
+        if (arena.capacity() < 4096) return TEST_ERROR();
+
+        arena.release();
+        if (arena.capacity() != 0 || arena.used() != 0) return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        json::arena arena{};
+        std::pmr::vector<int> values{&arena};
+        for (auto i = 0; i < 1000; i++) values.push_back(i);
+        if (values.back() != 999 || arena.used() == 0) return TEST_ERROR();
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "../../build/include/binding.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+struct point {
+    int x{};
+    int y{};
+};
+
+struct shape {
+    std::string name{};
+    std::vector<point> points{};
+    std::optional<float> area{};
+    bool closed{false};
+};
+
+JSON_BIND(point, json::member{"x", &point::x}, json::member{"y", &point::y});
+JSON_BIND(shape, json::member{"name", &shape::name},
+          json::member{"points", &shape::points},
+          json::member{"area", &shape::area},
+          json::member{"closed", &shape::closed});
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        try {
+            const auto value = json::deserialize_as<shape>(
+                R"({"points": [{"x": 1, "y": 2}, {"y": 4, "x": 3}],)"
+                R"( "extra": {"nested": [1, {"a": null}]},)"
+                R"( "name": "triangle", "area": 1.5, "closed": true})");
+
+            if (value.name != "triangle" || !value.closed) return TEST_ERROR();
+            if (value.points.size() != 2) return TEST_ERROR();
+            if (value.points[1].x != 3 || value.points[1].y != 4)
+                return TEST_ERROR();
+            if (value.area != 1.5f) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            const auto value = json::deserialize_as<std::vector<point>>(
+                R"([{"x": 1}, {"y": 2}])");
+            if (value.size() != 2 || value[0].x != 1 || value[0].y != 0)
+                return TEST_ERROR();
+            if (value[1].x != 0 || value[1].y != 2) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            const auto _ =
+                json::deserialize_as<point>(R"({"x": "one", "y": 2})");
+        } catch (const json::invalid_json_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // doubles overflowing the member are mismatches, underflows zero
+        for (const auto content :
+             {R"({"name": "a", "area": 1e400})",
+              R"({"name": "a", "area": 1e39})",
+              R"({"name": "a", "area": -1e39})"}) {
+            try {
+                const auto _ = json::deserialize_as<shape>(content);
+                return TEST_ERROR();
+            } catch (const json::invalid_json_exception&) {
+            } catch (const std::exception& ex) {
+                log_exception(ex.what());
+                return TEST_ERROR();
+            }
+        }
+
+        try {
+            const auto value =
+                json::deserialize_as<shape>(R"({"area": 1e-400})");
+            if (value.area != 0.0f) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const shape value{"line", {{1, 2}, {3, 4}}, std::nullopt, false};
+        if (json::serialize(value) !=
+            R"({"name":"line","points":[{"x":1,"y":2},{"x":3,"y":4}],)"
+            R"("area":null,"closed":false})")
+            return TEST_ERROR();
+
+        if (json::serialize(point{5, 6}, {.indent = 2}) !=
+            "{\n  \"x\": 5,\n  \"y\": 6\n}")
+            return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        // generated serializer and decoder agree with each other
+        const shape value{"square", {{0, 0}, {0, 1}, {1, 1}}, 1.f, true};
+        const auto decoded =
+            json::deserialize_as<shape>(json::serialize(value));
+        if (decoded.name != value.name || decoded.area != value.area)
+            return TEST_ERROR();
+        if (decoded.points.size() != 3 || decoded.points[2].y != 1)
+            return TEST_ERROR();
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+#include "../../build/include/cbor.hpp"
+#include "../../build/include/parser.hpp"
+#include "../../build/include/serializer.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+auto bytes(std::initializer_list<unsigned> values) -> std::string {
+    std::string retval{};
+    for (const auto value : values) retval += static_cast<char>(value);
+    return retval;
+}
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const std::string content{
+            R"({"null":null,"bool":[true,false],"int":-69,"big":)"
+            R"(18446744073709551615,"min":-9223372036854775808,)"
+            R"("float":420.5,"double":0.1,"string":"café 🚀",)"
+            R"("nested":{"empty":[],"list":[1,[2,{}]]}})"};
+
+        try {
+            const auto root = json::deserialize(content);
+            const auto encoded = json::serialize_cbor(root);
+            if (json::serialize(json::deserialize_cbor(encoded)) != content)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            // shortest heads, single precision when exact
+            const auto map = json::deserialize(R"({"a":1,"b":[2,3]})");
+            if (json::serialize_cbor(map) !=
+                bytes({0xa2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03}))
+                return TEST_ERROR();
+            const auto list = json::deserialize("[100000,-1,1.5,1.1]");
+            if (json::serialize_cbor(list) !=
+                bytes({0x84, 0x1a, 0x00, 0x01, 0x86, 0xa0, 0x20, 0xfa, 0x3f,
+                       0xc0, 0x00, 0x00, 0xfb, 0x3f, 0xf1, 0x99, 0x99, 0x99,
+                       0x99, 0x99, 0x9a}))
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            // examples of rfc 8949 appendix a from other encoders
+            const auto nested = json::deserialize_cbor(
+                bytes({0x9f, 0x01, 0x82, 0x02, 0x03, 0x9f, 0x04, 0x05, 0xff,
+                       0xff}));
+            if (json::serialize(nested) != "[1,[2,3],[4,5]]")
+                return TEST_ERROR();
+
+            const auto map = json::deserialize_cbor(bytes(
+                {0xbf, 0x61, 0x61, 0x01, 0x61, 0x62, 0x9f, 0x02, 0x03, 0xff,
+                 0xff}));
+            if (json::serialize(map) != R"({"a":1,"b":[2,3]})")
+                return TEST_ERROR();
+
+            const auto chunks = json::deserialize_cbor(bytes(
+                {0x7f, 0x65, 0x73, 0x74, 0x72, 0x65, 0x61, 0x64, 0x6d, 0x69,
+                 0x6e, 0x67, 0xff}));
+            if (chunks.string() != "streaming") return TEST_ERROR();
+
+            const auto halves = json::deserialize_cbor(
+                bytes({0x83, 0xf9, 0x3c, 0x00, 0xf9, 0xc4, 0x00, 0xf9, 0x00,
+                       0x01}));
+            if (halves.at(0).value<double>() != 1.0 ||
+                halves.at(1).value<double>() != -4.0 ||
+                halves.at(2).value<double>() != 5.960464477539063e-8)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        std::string content{"["};
+        for (int i{0}; i < 100; i++)
+            content += std::format(
+                R"({}{{"identifier":{},"description":"repeated value"}})",
+                i == 0 ? "" : ",", i);
+        content += ']';
+
+        try {
+            const auto root = json::deserialize(content);
+            const auto plain = json::serialize_cbor(root);
+            const auto shared =
+                json::serialize_cbor(root, {.key_dictionary = true});
+            if (!shared.starts_with(bytes({0xd9, 0x01, 0x00})) ||
+                shared.size() * 2 > plain.size())
+                return TEST_ERROR();
+            if (json::serialize(json::deserialize_cbor(shared)) != content)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // 2^64 as a positive bignum
+        const auto bignum{bytes({0xc2, 0x49, 0x01, 0x00, 0x00, 0x00, 0x00,
+                                 0x00, 0x00, 0x00, 0x00})};
+
+        try {
+            const auto raw =
+                json::deserialize_cbor(bignum, {.raw_numbers = true});
+            if (json::serialize(raw) != "18446744073709551616")
+                return TEST_ERROR();
+            if (json::deserialize_cbor(bignum).value<double>() != 0x1p64)
+                return TEST_ERROR();
+
+            const std::string content{
+                R"([-18446744073709551617,3.141592653589793238462643383279,)"
+                R"(-1.000000000000000000005e-300,12345678901234567890123e5])"};
+            const auto root = json::deserialize(content, {.raw_numbers = true});
+            const auto decoded = json::deserialize_cbor(
+                json::serialize_cbor(root), {.raw_numbers = true});
+            if (json::serialize(decoded) !=
+                R"([-18446744073709551617,3141592653589793238462643383279e-30,)"
+                R"(-1000000000000000000005e-321,12345678901234567890123e5])")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string malformed[]{
+            bytes({0x82, 0x01}),
+            bytes({0x01, 0x02}),
+            bytes({0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}),
+            bytes({0xa1, 0x01, 0x02}),
+            bytes({0xa2, 0x61, 0x61, 0x01, 0x61, 0x61, 0x02}),
+            bytes({0x42, 0x01, 0x02}),
+            bytes({0x62, 0xc3, 0x28}),
+            bytes({0xd8, 0x19, 0x00}),
+            bytes({0x1c})};
+
+        for (const auto& content : malformed) {
+            try {
+                (void)json::deserialize_cbor(content);
+                return TEST_ERROR();
+            } catch (const json::invalid_cbor_exception&) {
+            } catch (const std::exception& ex) {
+                log_exception(ex.what());
+                return TEST_ERROR();
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        // objects past the linear scan limit keep every key findable
+        const std::string content{
+            R"({"k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5,)"
+            R"( "k6": 6, "k7": 7, "k8": 8, "k9": 9})"};
+
+        try {
+            const auto root = json::deserialize_cbor(
+                json::serialize_cbor(json::deserialize(content)));
+            if (root.fields().size() != 10 || !root.fields().contains("k0") ||
+                root.field("k8").value<int>() != 8)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // exponents without a decimal fraction encoding are not rewritten
+        for (const auto content :
+             {"[1e99999999999999999999999]", "[1.5e-9223372036854775808]",
+              "[1e-9223372036854775808]"}) {
+            try {
+                const auto root =
+                    json::deserialize(content, {.raw_numbers = true});
+                const auto _ = json::serialize_cbor(root);
+                log_info(content, __LINE__);
+                return TEST_ERROR();
+            } catch (const json::invalid_cbor_exception&) {
+            } catch (const std::exception& ex) {
+                log_exception(ex.what());
+                return TEST_ERROR();
+            }
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+#include "../../build/include/image.hpp"
+#include "../../build/include/parser.hpp"
+#include "../../build/include/serializer.hpp"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const std::string content{
+            R"({
+                "null": null,
+                "bool": [true, false],
+                "numbers": {
+                    "int": -69,
+                    "big": 18446744073709551615,
+                    "wide": -9223372036854775808,
+                    "float": 420.5
+                },
+                "string": "test string"
+        })"};
+
+        try {
+            const json::image image{json::serialize_image(
+                json::deserialize(content))};
+            const auto root = image.root();
+            if (root.tag() != json::node_tag::JsonObject || root.size() != 4)
+                return TEST_ERROR();
+            if (root.field("null").tag() != json::node_tag::JsonNull)
+                return TEST_ERROR();
+            const auto boolValues = root.field("bool");
+            if (boolValues.size() != 2 || !boolValues.at(0).value<bool>() ||
+                boolValues.at(1).value<bool>())
+                return TEST_ERROR();
+            const auto numberValues = root.field("numbers");
+            if (numberValues.field("int").value<int>() != -69 ||
+                numberValues.field("big").value<std::uint64_t>() !=
+                    18446744073709551615u ||
+                numberValues.field("wide").value<std::int64_t>() !=
+                    std::numeric_limits<std::int64_t>::min() ||
+                numberValues.field("float").value<float>() != 420.5f)
+                return TEST_ERROR();
+            if (root.field("string").value<std::string_view>() !=
+                "test string")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // keys out of order, so lookups go through the sorted index
+        std::string content{"{"};
+        for (int i{99}; i >= 0; i--)
+            content += std::format(R"({}"key{}":[{},"value {}"])",
+                                   i == 99 ? "" : ",", i, i, i);
+        content += '}';
+
+        try {
+            const auto root = json::deserialize(content);
+            const auto bytes = json::serialize_image(root);
+            const json::image image{bytes};
+            for (int i{0}; i < 100; i++) {
+                const auto item = image.root().field(std::format("key{}", i));
+                if (item.at(0).value<int>() != i ||
+                    item.at(1).value<std::string>() !=
+                        std::format("value {}", i))
+                    return TEST_ERROR();
+            }
+            if (image.root().contains("key100") ||
+                !image.root().contains("key0"))
+                return TEST_ERROR();
+
+            // document order is kept
+            if (json::serialize(image.root().to_node()) != content)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"([[1,[2,3]],{"a":{"b":[]}},4.5,"last",)"
+            R"(123456789012345678901234567890])"};
+        const auto path{std::filesystem::temp_directory_path() /
+                        "cppjson_image_test.img"};
+
+        try {
+            const auto root =
+                json::deserialize(content, {.raw_numbers = true});
+            std::ofstream{path, std::ios::binary}
+                << json::serialize_image(root);
+
+            json::image image{path.c_str()};
+            const auto moved{std::move(image)};
+            std::filesystem::remove(path);
+
+            const auto mapped = moved.root();
+            if (mapped.at(0).at(1).at(1).value<int>() != 3 ||
+                mapped.at(1).field("a").field("b").size() != 0 ||
+                mapped.at(2).value<double>() != 4.5 ||
+                mapped.at(4).tag() != json::node_tag::JsonInt)
+                return TEST_ERROR();
+            if (json::serialize(mapped.to_node()) != content)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const auto bytes = json::serialize_image(json::deserialize("[1]"));
+        try {
+            const json::image image{std::string_view{bytes}.substr(0, 16)};
+        } catch (const json::invalid_image_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // counts are checked before sizing anything from them
+        for (const auto content : {"[1]", R"({"a":1})"}) {
+            auto bytes = json::serialize_image(json::deserialize(content));
+            const std::uint64_t count{std::uint64_t{1} << 40};
+            // the root container follows the 24 bytes header
+            std::memcpy(bytes.data() + 24, &count, sizeof(count));
+            const json::image image{bytes};
+            try {
+                const auto _ = image.root().to_node();
+                return TEST_ERROR();
+            } catch (const json::invalid_image_exception&) {
+            } catch (const std::exception& ex) {
+                log_exception(ex.what());
+                return TEST_ERROR();
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        // a container pointing back at its parent is not followed
+        auto bytes = json::serialize_image(json::deserialize("[[1]]"));
+        const std::uint64_t word{std::uint64_t{'['} << 56 | 24};
+        // the word of the first item of the root, at offset 24
+        std::memcpy(bytes.data() + 32, &word, sizeof(word));
+        const json::image image{bytes};
+        try {
+            const auto _ = image.root().to_node();
+        } catch (const json::invalid_image_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // narrowing is range checked like `node::value<int>`
+        const auto bytes = json::serialize_image(
+            json::deserialize("[2147483647, 3000000000, -3000000000]"));
+        const json::image image{bytes};
+        const auto root = image.root();
+        if (root.at(0).value<int>() != 2147483647) return TEST_ERROR();
+        for (uint idx{1}; idx < root.size(); idx++) {
+            try {
+                const auto _ = root.at(idx).value<int>();
+                return TEST_ERROR();
+            } catch (const json::node_exception&) {
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        const auto bytes =
+            json::serialize_image(json::deserialize(R"({"a":[1]})"));
+        const json::image image{bytes};
+        try {
+            const auto _ = image.root().field("a").at(1);
+        } catch (const std::out_of_range&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // objects past the linear scan limit keep every key findable
+        const std::string content{
+            R"({"k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5,)"
+            R"( "k6": 6, "k7": 7, "k8": 8, "k9": 9})"};
+
+        try {
+            const auto bytes =
+                json::serialize_image(json::deserialize(content));
+            const auto root = json::image{bytes}.root().to_node();
+            if (root.fields().size() != 10 || !root.fields().contains("k0") ||
+                root.field("k8").value<int>() != 8)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
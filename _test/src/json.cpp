@@ -2,6 +2,7 @@
 
 #include <sys/types.h>
 
+#include <cstdint>
 #include <cstring>
 #include <format>
 #include <functional>
@@ -244,6 +245,149 @@ static std::vector<std::function<bool()>> tests{
         if (node.at(1).value<float>() != 420.f) return TEST_ERROR();
         return TEST_OK();
     },
+    [] {
+        const json::node node{json::array{json::node{69}, json::node{420.f}}};
+        try {
+            if (node.items().size() != 2) return TEST_ERROR();
+            if (node.items()[0].value<int>() != 69) return TEST_ERROR();
+            const auto& _ = node.fields();
+        } catch (const json::node_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        const json::node node{json::object{{"first", json::node{69}}}};
+        try {
+            if (node.fields().size() != 1) return TEST_ERROR();
+            if (node.fields().begin()->first != "first") return TEST_ERROR();
+            const auto& _ = node.items();
+        } catch (const json::node_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        json::object value{{"zeta", json::node{1}}, {"alpha", json::node{2}}};
+        value["mid"] = json::node{3};
+        if (value.emplace("alpha", json::node{4}).second) return TEST_ERROR();
+
+        const char* expected[]{"zeta", "alpha", "mid"};
+        std::size_t idx{0};
+        for (const auto& [key, field] : value)
+            if (key != expected[idx++]) return TEST_ERROR();
+        if (value.at("alpha").value<int>() != 2) return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        // enough fields to leave the linear scan for the hash index
+        json::object value{};
+        for (auto i = 0; i < 100; i++)
+            value.emplace(std::format("key{}", i), json::node{i});
+
+        for (auto i = 0; i < 100; i++) {
+            const auto key = std::format("key{}", i);
+            const auto it = value.find(std::string_view{key});
+            if (it == value.end() || it->second.value<int>() != i)
+                return TEST_ERROR();
+        }
+        if (value.contains("key100")) return TEST_ERROR();
+
+        if (!value.erase("key42") || value.erase("key42")) return TEST_ERROR();
+        if (value.size() != 99 || value.contains("key42")) return TEST_ERROR();
+        if (value.at("key99").value<int>() != 99) return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        const json::object value{{"first", json::node{69}}};
+        try {
+            const auto& _ = value.at("second");
+        } catch (const std::out_of_range&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // moving a container into a node keeps its storage
+        json::array value{json::node{69}, json::node{420.f}};
+        const auto data = value.data();
+        json::node node{std::move(value)};
+        if (node.items().data() != data) return TEST_ERROR();
+        if (node.span().size() != 2 || &node.span()[0] != data)
+            return TEST_ERROR();
+
+        const auto moved = std::move(node).value<json::array>();
+        if (moved.data() != data) return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        json::node node{json::object{{"list", json::node{json::array{}}}}};
+        node.field("list").get<json::array>().emplace_back(1);
+        node.fields().emplace("name", json::node{std::string_view{"value"}});
+
+        if (node.field("list").items().size() != 1) return TEST_ERROR();
+        if (node.field("name").string() != "value") return TEST_ERROR();
+        if (node.get_if<json::array>() != nullptr) return TEST_ERROR();
+        if (node.get_if<json::object>() == nullptr) return TEST_ERROR();
+        try {
+            const auto& _ = node.get<json::array>();
+        } catch (const json::node_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        const json::node large{UINT64_MAX};
+        const json::node raw{json::raw_number{"123456789012345678901"}};
+        if (large.tag() != json::node_tag::JsonInt ||
+            raw.tag() != json::node_tag::JsonInt)
+            return TEST_ERROR();
+        if (large.value<std::uint64_t>() != UINT64_MAX ||
+            large.value<double>() != 18446744073709551615.0 ||
+            raw.value<double>() != 123456789012345678901.0)
+            return TEST_ERROR();
+        try {
+            const auto _ = large.value<int>();
+        } catch (const json::node_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // keys added before the table built by `reserve` is used
+        json::object reserved{};
+        reserved.reserve(16);
+        for (int i{0}; i < 10; i++)
+            reserved.emplace(std::format("k{}", i), json::node{i});
+        if (!reserved.contains("k0") || reserved.at("k7").value<int>() != 7 ||
+            reserved.emplace("k0", json::node{}).second ||
+            reserved.size() != 10)
+            return TEST_ERROR();
+
+        const json::object listed{
+            {"k0", json::node{0}}, {"k1", json::node{1}}, {"k2", json::node{2}},
+            {"k3", json::node{3}}, {"k4", json::node{4}}, {"k5", json::node{5}},
+            {"k6", json::node{6}}, {"k7", json::node{7}}, {"k8", json::node{8}},
+            {"k9", json::node{9}}};
+        if (!listed.contains("k0") || listed.find("k3") == listed.end())
+            return TEST_ERROR();
+        return TEST_OK();
+    },
 };
 
 auto main(int argc, char** argv) -> int {
@@ -0,0 +1,139 @@
+#include "../../build/include/lazy.hpp"
+#include "../../build/include/lexer.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const std::string content{
+            R"({
+                "null": null,
+                "bool": [true, false],
+                "numbers": {
+                    "int": 69,
+                    "float": 420.5
+                },
+                "string": "test string"
+        })"};
+
+        try {
+            const auto document = json::deserialize_lazy(content);
+            const auto root = document.root();
+            if (root.tag() != json::node_tag::JsonObject || root.size() != 4)
+                return TEST_ERROR();
+            if (root.field("null").tag() != json::node_tag::JsonNull)
+                return TEST_ERROR();
+            const auto boolValues = root.field("bool");
+            if (boolValues.size() != 2 || !boolValues.at(0).value<bool>() ||
+                boolValues.at(1).value<bool>())
+                return TEST_ERROR();
+            const auto numberValues = root.field("numbers");
+            if (numberValues.field("int").tag() != json::node_tag::JsonInt ||
+                numberValues.field("int").value<int>() != 69 ||
+                numberValues.field("float").value<float>() != 420.5f)
+                return TEST_ERROR();
+            if (root.field("string").value<std::string>() != "test string")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // values are only validated once they are read, and cached after
+        const std::string content{R"([{"bad": tru}, {"good": [1, 2]}])"};
+        try {
+            const auto document = json::deserialize_lazy(content);
+            const auto& items =
+                document.root().at(1).field("good").materialize();
+            if (items.items().size() != 2) return TEST_ERROR();
+            if (&document.root().at(1).field("good").materialize() != &items)
+                return TEST_ERROR();
+            const auto _ = document.root().at(0).field("bad").value<bool>();
+        } catch (const json::invalid_json_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        for (const auto content : {R"([1, [2, 3])", R"({"a": [}])",
+                                   R"([1] [2])", R"("string")"}) {
+            try {
+                const auto _ = json::deserialize_lazy(content);
+                return TEST_ERROR();
+            } catch (const json::invalid_json_exception&) {
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        const auto document = json::deserialize_lazy(R"({"first": [1, 2,]})");
+        try {
+            const auto _ = document.root().field("first").size();
+        } catch (const json::invalid_json_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        const auto document = json::deserialize_lazy(R"({"first": [1]})");
+        try {
+            const auto _ = document.root().field("first").at(1);
+        } catch (const std::out_of_range&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "../../build/include/ndjson.hpp"
+#include "../../build/include/parser.hpp"
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static auto make_records(int count) -> std::string {
+    std::string retval{};
+    for (auto i = 0; i < count; i++) {
+        retval += std::format(R"({{"id": {}, "tags": ["a", "b"]}})", i);
+        retval += i % 10 == 0 ? "\r\n\n" : "\n";
+    }
+    return retval;
+}
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const auto content = make_records(1000);
+        try {
+            const auto batch = json::deserialize_ndjson(content, {.threads = 4});
+            if (batch.size() != 1000) return TEST_ERROR();
+            for (auto i = 0; i < 1000; i++)
+                if (batch[i].field("id").value<int>() != i) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const auto content = make_records(500);
+        try {
+            std::atomic<long> sum{0};
+            std::atomic<int> count{0};
+            json::for_each_ndjson(
+                content,
+                [&](std::size_t idx, const json::node& record) {
+                    if (record.field("id").value<int>() != (int)idx) return;
+                    sum += record.field("id").value<int>();
+                    count++;
+                },
+                {.threads = 3, .borrow_strings = true});
+            if (count != 500 || sum != 499 * 500 / 2) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const auto content = make_records(200) + "{\"broken\": }\n";
+        try {
+            const auto _ = json::deserialize_ndjson(content, {.threads = 2});
+        } catch (const json::invalid_json_exception& ex) {
+            if (std::string{ex.what()}.find("record 200") == std::string::npos)
+                return TEST_ERROR();
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        try {
+            const auto batch = json::deserialize_ndjson("\n  \n");
+            if (batch.size() != 0) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "../../build/include/parallel.hpp"
+#include "../../build/include/parser.hpp"
+#include "../../build/include/serializer.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+// items with strings holding brackets, commas, quotes and backslashes so the
+// chunk boundaries fall in every possible state
+static auto make_array(int count) -> std::string {
+    std::string retval{"[\n"};
+    for (auto i = 0; i < count; i++) {
+        if (i > 0) retval += ",\n";
+        retval += std::format(
+            R"({{"id": {}, "text": "a, [b] {{c}} \"d\" \\", "list": [[{}], {{}}]}})",
+            i, i % 7);
+    }
+    retval += "\n]\n";
+    return retval;
+}
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const auto content = make_array(2000);
+        try {
+            const auto expected = json::deserialize(content);
+            for (const auto chunkSize : {64, 97, 1000, 4096}) {
+                const auto root = json::deserialize_parallel(
+                    content, {.threads = 4,
+                              .chunk_size = static_cast<std::size_t>(chunkSize)});
+                if (root.items().size() != 2000) return TEST_ERROR();
+                if (json::serialize(root) != json::serialize(expected))
+                    return TEST_ERROR();
+            }
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            // small inputs and object roots take the sequential path
+            const auto root = json::deserialize_parallel(
+                R"({"a": [1, 2]})", {.chunk_size = 4});
+            if (root.field("a").items().size() != 2) return TEST_ERROR();
+            if (!json::deserialize_parallel("[]", {.chunk_size = 1})
+                     .items()
+                     .empty())
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        for (const auto content :
+             {"[1, 2, 3, 4, 5, 6, 7, 8, ]", "[1, 2, 3, , 4, 5, 6, 7, 8]",
+              "[1, 2, 3, 4] [5, 6, 7, 8]", "[1, 2, [3, 4, 5, 6, 7, 8]",
+              "[1, 2, 3, 4, 5, 6, 7, 8, \"9]"}) {
+            try {
+                const auto _ = json::deserialize_parallel(
+                    content, {.threads = 2, .chunk_size = 4});
+                return TEST_ERROR();
+            } catch (const json::invalid_json_exception&) {
+            }
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
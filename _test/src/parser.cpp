@@ -2,6 +2,8 @@
 
 #include <sys/types.h>
 
+#include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <format>
@@ -138,6 +140,311 @@ static std::vector<std::function<bool()>> tests{
             return TEST_ERROR();
         }
         return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"([1e10, -0.5E-3, 0, -0, 2.5e+2, 3000000000])"};
+
+        try {
+            const auto node = json::deserialize(content);
+            if (node.at(0).value<float>() != 1e10f ||
+                node.at(1).value<float>() != -0.5E-3f ||
+                node.at(2).value<int>() != 0 || node.at(3).value<int>() != 0 ||
+                node.at(4).value<float>() != 250.f ||
+                node.at(5).value<float>() != 3e9f)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"([9223372036854775807, -9223372036854775808,)"
+            R"( 18446744073709551615, 18446744073709551616, 0.1,)"
+            R"( 2.2250738585072014e-308, 9007199254740993.0])"};
+
+        try {
+            const auto node = json::deserialize(content);
+            if (node.at(0).value<std::int64_t>() != INT64_MAX ||
+                node.at(1).value<std::int64_t>() != INT64_MIN ||
+                node.at(2).value<std::uint64_t>() != UINT64_MAX ||
+                node.at(3).value<double>() != 18446744073709551616.0 ||
+                node.at(4).value<double>() != 0.1 ||
+                node.at(5).value<double>() != 2.2250738585072014e-308 ||
+                node.at(6).value<double>() != 9007199254740992.0)
+                return TEST_ERROR();
+            if (node.at(2).tag() != json::node_tag::JsonInt ||
+                node.at(3).tag() != json::node_tag::JsonFloat)
+                return TEST_ERROR();
+
+            const auto _ = node.at(2).value<std::int64_t>();
+        } catch (const json::node_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // underflows round to zero, overflows are errors unless kept raw
+        const std::string content{R"([1e-400, -1e-400, 4.9e-324, 1e400])"};
+
+        try {
+            const auto _ = json::deserialize(content);
+            return TEST_ERROR();
+        } catch (const json::invalid_json_exception&) {
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+
+        try {
+            const auto node = json::deserialize("[1e-400, -1e-400, 4.9e-324]");
+            if (node.at(0).value<double>() != 0.0 ||
+                !std::signbit(node.at(1).value<double>()) ||
+                node.at(2).value<double>() != 4.9e-324)
+                return TEST_ERROR();
+
+            const auto raw = json::deserialize(content, {.raw_numbers = true});
+            const auto underflow = raw.at(0).get_if<json::raw_number>();
+            const auto overflow = raw.at(3).get_if<json::raw_number>();
+            if (!underflow || underflow->lexeme != "1e-400" || !overflow ||
+                overflow->lexeme != "1e400")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"({"plain": "no escapes at all", "quote": "say \"hi\"\n",)"
+            R"( "unicode": "caf\u00e9 \u6771 \uD83D\ude00 \/",)"
+            R"( "key": "\\ \b\f\r\t", "raw": "naïve 東京 🚀"})"};
+
+        try {
+            const auto node =
+                json::deserialize(content, {.borrow_strings = true});
+            const auto plain = node.field("plain").string();
+            if (plain.data() < content.data() ||
+                plain.data() >= content.data() + content.size())
+                return TEST_ERROR();
+            if (node.field("quote").string() != "say \"hi\"\n" ||
+                node.field("unicode").string() !=
+                    "caf\xC3\xA9 \xE6\x9D\xB1 \xF0\x9F\x98\x80 /" ||
+                node.field("key").string() != "\\ \b\f\r\t" ||
+                node.field("raw").string() != "naïve 東京 🚀")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        for (const auto content :
+             {R"(["\x"])", R"(["\u12"])", R"(["\u12G4"])", R"(["\ud83d"])",
+              R"(["\ude00"])", R"(["\ud83dA"])", "[\"tab\tinside\"]",
+              "[\"\xC3\"]", "[\"\xC0\xAF\"]", "[\"\xED\xA0\x80\"]",
+              "[\"\xF4\x90\x80\x80\"]", "[\"\xFF\"]", "[\"abc\\",
+              "[\"\\"}) {
+            try {
+                const auto _ = json::deserialize(content);
+                return TEST_ERROR();
+            } catch (const json::invalid_json_exception&) {
+            } catch (const std::exception& ex) {
+                log_exception(ex.what());
+                return TEST_ERROR();
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        for (const auto content : {"[01]", "[1.]", "[.5]", "[+1]", "[1e]",
+                                   "[-]", "[1.5x]", "[1 2]", "[1,]",
+                                   "[1,,2]", R"({"a": 1,})", "[1]]"}) {
+            try {
+                const auto _ = json::deserialize(content);
+                return TEST_ERROR();
+            } catch (const json::invalid_json_exception&) {
+            } catch (const std::exception& ex) {
+                log_exception(ex.what());
+                return TEST_ERROR();
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{R"({"first": "hello", "second": ["world"]})"};
+
+        try {
+            const auto node =
+                json::deserialize(content, {.borrow_strings = true});
+            const auto first = node.field("first").value<std::string_view>();
+            if (first != "hello" || first.data() < content.data() ||
+                first.data() >= content.data() + content.size())
+                return TEST_ERROR();
+            if (node.field("second").at(0).value<std::string>() != "world")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const char buffer[]{'[', '1', ',', ' ', '"', 'a', '"', ']'};
+
+        try {
+            const auto node = json::deserialize(std::span{buffer});
+            if (node.at(0).value<int>() != 1 ||
+                node.at(1).value<std::string>() != "a")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            const auto res = json::deserialize_mapped(
+                "/home/giorgi/git/personal/cppjson/_test/data/weather.json",
+                {.borrow_strings = true});
+            const auto source = res.source.view();
+            const auto cod = res.root.field("cod").value<std::string_view>();
+            if (cod != "200" || cod.data() < source.data() ||
+                cod.data() >= source.data() + source.size())
+                return TEST_ERROR();
+            if (res.root.field("list")
+                    .at(1)
+                    .field("main")
+                    .field("temp")
+                    .value<float>() != 296.31f)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"({"values": [1, 2.5, "a string that is too long for sso"],
+                "nested": {"key": null}})"};
+
+        try {
+            json::arena arena{};
+            for (auto i = 0; i < 2; i++) {
+                {
+                    const auto node =
+                        json::deserialize(content, {.resource = &arena});
+                    const auto& values = node.field("values");
+                    if (values.at(0).value<int>() != 1 ||
+                        values.at(1).value<float>() != 2.5f ||
+                        values.at(2).value<std::string>() !=
+                            "a string that is too long for sso")
+                        return TEST_ERROR();
+                    if (node.field("nested").field("key").tag() !=
+                        json::node_tag::JsonNull)
+                        return TEST_ERROR();
+                }
+
+                if (arena.used() == 0) return TEST_ERROR();
+                arena.reset();
+            }
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        json::parser parser{};
+        try {
+            for (auto i = 0; i < 100; i++) {
+                auto& root = parser.parse(std::format(
+                    R"({{"id": {}, "name": "message number {}", "ok": true}})",
+                    i, i));
+                if (root.field("id").value<int>() != i) return TEST_ERROR();
+                if (root.field("name").string() !=
+                    std::format("message number {}", i))
+                    return TEST_ERROR();
+            }
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // a failed document leaves the parser usable
+        json::parser parser{};
+        try {
+            const auto& _ = parser.parse(R"({"a": [1, 2, {"b": tru}]})");
+            return TEST_ERROR();
+        } catch (const json::invalid_json_exception&) {
+        }
+
+        try {
+            const auto& root = parser.parse(R"([[1], {"b": false}])");
+            if (root.at(0).at(0).value<int>() != 1 ||
+                root.at(1).field("b").value<bool>())
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"([{"id": 1, "name": "a"}, {"id": 2, "name": "b"},)"
+            R"( {"name": "c", "id": 3}])"};
+
+        try {
+            json::symbol_table symbols{};
+            const auto root = json::deserialize(content, {.symbols = &symbols});
+            if (symbols.size() != 2) return TEST_ERROR();
+
+            // every record shares the characters of its keys
+            const auto& records = root.items();
+            if (records[0].fields().begin()->first.view().data() !=
+                records[1].fields().begin()->first.view().data())
+                return TEST_ERROR();
+
+            const auto id = symbols.find("id");
+            for (auto i = 0; i < 3; i++)
+                if (records[i].field(id).value<int>() != i + 1)
+                    return TEST_ERROR();
+            if (records[2].field("name").string() != "c") return TEST_ERROR();
+            if (symbols.find("missing").name.data() != nullptr)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        json::parser parser{{.intern_keys = true}};
+        try {
+            for (auto i = 0; i < 10; i++) {
+                const auto& root =
+                    parser.parse(std::format(R"({{"seq": {}, "ok": true}})", i));
+                const auto seq = parser.symbols().find("seq");
+                if (root.field(seq).value<int>() != i) return TEST_ERROR();
+            }
+            if (parser.symbols().size() != 2) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
     }};
 
 auto main(int argc, char** argv) -> int {
@@ -0,0 +1,163 @@
+#include "../../build/include/parser.hpp"
+#include "../../build/include/path.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static const std::string content{
+    R"({
+        "store": {
+            "book": [
+                {"title": "first", "price": 8},
+                {"title": "second", "price": 12.5, "tags": ["a", "b"]}
+            ],
+            "a/b": {"m~n": true},
+            "0": "key"
+        }
+})"};
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        try {
+            const auto root = json::deserialize(content);
+            const auto title = json::path::pointer("/store/book/1/title");
+            const auto found = title.find(root);
+            if (!found || found->string() != "second") return TEST_ERROR();
+
+            const auto escaped = json::path::pointer("/store/a~1b/m~0n");
+            if (!escaped.find(root) || !escaped.find(root)->value<bool>())
+                return TEST_ERROR();
+            if (json::path::pointer("/store/0").find(root)->string() != "key")
+                return TEST_ERROR();
+            if (json::path::pointer("").find(root) != &root)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            const auto root = json::deserialize(content);
+            // misses are reported without throwing
+            for (const auto expression :
+                 {"/store/book/2", "/store/missing", "/store/book/01",
+                  "/store/book/0/title/x"})
+                if (json::path::pointer(expression).find(root))
+                    return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            const auto root = json::deserialize(content);
+            const auto prices = json::path::jsonpath("$.store.book[*]['price']");
+            std::vector<const json::node*> matches{};
+            prices.select(root, matches);
+            if (matches.size() != 2 || matches[0]->value<int>() != 8 ||
+                matches[1]->value<float>() != 12.5f)
+                return TEST_ERROR();
+
+            const auto tag = json::path::jsonpath("$.store.book[1].tags[0]");
+            if (!tag.find(root) || tag.find(root)->string() != "a")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // only the matching values are built while walking the events
+        try {
+            std::vector<std::string> titles{};
+            json::path::jsonpath("$.store.book[*].title")
+                .select(content, [&](json::node&& value) {
+                    titles.emplace_back(value.string());
+                });
+            if (titles != std::vector<std::string>{"first", "second"})
+                return TEST_ERROR();
+
+            std::size_t count{0};
+            json::path::pointer("/store/book/1").select(
+                content, [&](json::node&& value) {
+                    count += value.fields().size();
+                });
+            if (count != 3) return TEST_ERROR();
+
+            // same query over a document streamed in small chunks
+            titles.clear();
+            const auto query = json::path::jsonpath("$.store.book[*].title");
+            json::path_matcher matcher{query, [&](json::node&& value) {
+                                           titles.emplace_back(value.string());
+                                       }};
+            json::reader reader{};
+            for (std::size_t idx{0}; idx < content.size(); idx += 7)
+                reader.feed(std::string_view{content}.substr(idx, 7), matcher);
+            reader.finish(matcher);
+            if (titles != std::vector<std::string>{"first", "second"})
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        for (const auto expression : {"store", "$.", "$[1", "$['a]", "$x"}) {
+            try {
+                const auto _ = expression[0] == '$'
+                                   ? json::path::jsonpath(expression)
+                                   : json::path::pointer(expression);
+                return TEST_ERROR();
+            } catch (const json::invalid_path_exception&) {
+            }
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
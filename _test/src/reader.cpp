@@ -0,0 +1,188 @@
+#include "../../build/include/reader.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static auto describe(json::event_tag event, const json::reader& reader)
+    -> std::string {
+    switch (event) {
+        case json::event_tag::JsonNull:
+            return "null";
+        case json::event_tag::JsonBool:
+            return reader.boolean() ? "true" : "false";
+        case json::event_tag::JsonNumber:
+            return std::visit(
+                [](auto value) { return std::format("number {}", value); },
+                reader.number());
+        case json::event_tag::JsonString:
+            return std::format("string {}", reader.string());
+        case json::event_tag::ObjectKey:
+            return std::format("key {}", reader.string());
+        case json::event_tag::ArrayStart:
+            return "[";
+        case json::event_tag::ArrayEnd:
+            return "]";
+        case json::event_tag::ObjectStart:
+            return "{";
+        case json::event_tag::ObjectEnd:
+            return "}";
+        case json::event_tag::DocumentEnd:
+            return "end";
+        case json::event_tag::NeedInput:
+            return "more";
+    }
+    return {};
+}
+
+static const std::string content{
+    R"({"name": "weather", "list": [{"dt": 1661857200, "temp": -1.5e2},
+       true, null, false, [], {}], "escaped": "a\"b"})"};
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const std::vector<std::string> expected{
+            "{",          "key name",      "string weather",
+            "key list",   "[",             "{",
+            "key dt",     "number 1661857200", "key temp",
+            "number -150", "}",            "true",
+            "null",       "false",         "[",
+            "]",          "{",             "}",
+            "]",          "key escaped",   "string a\"b",
+            "}",          "end"};
+
+        try {
+            json::reader reader{content};
+            std::vector<std::string> events{};
+            for (auto event = reader.next();; event = reader.next()) {
+                events.push_back(describe(event, reader));
+                if (event == json::event_tag::DocumentEnd) break;
+            }
+            if (events != expected) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            std::vector<std::string> expected{};
+            json::reader whole{content};
+            for (auto event = whole.next();; event = whole.next()) {
+                expected.push_back(describe(event, whole));
+                if (event == json::event_tag::DocumentEnd) break;
+            }
+
+            for (std::size_t chunkSize = 1; chunkSize < 8; chunkSize++) {
+                std::vector<std::string> events{};
+                const auto handler = [&](json::event_tag event,
+                                         const json::reader& reader) {
+                    events.push_back(describe(event, reader));
+                };
+
+                json::reader reader{};
+                for (std::size_t i = 0; i < content.size(); i += chunkSize)
+                    reader.feed(std::string_view{content}.substr(i, chunkSize),
+                                handler);
+                reader.finish(handler);
+                if (events != expected) return TEST_ERROR();
+            }
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        json::reader reader{};
+        try {
+            reader.feed(R"({"list": [1, 2)");
+            while (reader.next() != json::event_tag::NeedInput);
+            if (reader.depth() != 2) return TEST_ERROR();
+
+            reader.finish();
+            while (reader.next() != json::event_tag::DocumentEnd);
+        } catch (const json::invalid_json_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        json::reader reader{};
+        try {
+            reader.feed("[1] ");
+            while (reader.next() != json::event_tag::NeedInput);
+            reader.feed(" x");
+            reader.finish();
+            while (reader.next() != json::event_tag::DocumentEnd);
+        } catch (const json::invalid_json_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        try {
+            std::size_t numbers{0};
+            json::read_file_events(
+                "/home/giorgi/git/personal/cppjson/_test/data/weather.json",
+                [&](json::event_tag event, const json::reader&) {
+                    numbers += event == json::event_tag::JsonNumber;
+                },
+                16);
+            if (numbers == 0) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,297 @@
+#include "../../build/include/parser.hpp"
+#include "../../build/include/schema.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static const std::string userSchema{R"({
+    "$schema": "https://json-schema.org/draft/2020-12/schema",
+    "type": "object",
+    "required": ["id", "name"],
+    "properties": {
+        "id": {"type": "integer", "minimum": 1},
+        "name": {"type": "string", "minLength": 1, "maxLength": 8},
+        "age": {"type": "number", "exclusiveMaximum": 150},
+        "status": {"enum": ["active", "banned", null]},
+        "tags": {
+            "type": "array",
+            "maxItems": 3,
+            "items": {"type": "string", "maxLength": 5}
+        }
+    },
+    "additionalProperties": false
+})"};
+
+// path and message of the violation found while parsing, if any
+auto parse_violation(const json::schema& schema, std::string_view content)
+    -> std::optional<json::schema_error> {
+    try {
+        (void)json::deserialize(content, {.schema = &schema});
+    } catch (const json::schema_violation_exception& ex) {
+        return ex.error();
+    }
+    return std::nullopt;
+}
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const std::string content{
+            R"({"id": 7, "name": "café", "age": 31.5, "status": null,)"
+            R"( "tags": ["admin", "ops"]})"};
+
+        try {
+            const auto schema =
+                json::schema::compile(json::deserialize(userSchema));
+            if (schema.validate(json::deserialize(content)) ||
+                parse_violation(schema, content))
+                return TEST_ERROR();
+
+            const auto root = json::deserialize(content, {.schema = &schema});
+            if (root.field("tags").at(1).string() != "ops") return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::pair<std::string, json::schema_error> cases[]{
+            {R"({"id": 7, "name": 5})", {"/name", "unexpected integer value"}},
+            {R"({"name": "bob"})", {"", "missing required key `id`"}},
+            {R"({"id": 0, "name": "bob"})",
+             {"/id", "0 is below the minimum 1"}},
+            {R"({"id": 1.5, "name": "bob"})",
+             {"/id", "unexpected number value"}},
+            {R"({"id": 2.0, "name": "abcdefghi"})",
+             {"/name", "string is longer than 8 characters"}},
+            {R"({"id": 1, "name": "bob", "age": 150})",
+             {"/age", "150 is not below 150"}},
+            {R"({"id": 1, "name": "bob", "status": "gone"})",
+             {"/status", "value is not one of the allowed values"}},
+            {R"({"id": 1, "name": "bob", "tags": ["a", "banned"]})",
+             {"/tags/1", "string is longer than 5 characters"}},
+            {R"({"id": 1, "name": "bob", "tags": ["a", "b", "c", "d"]})",
+             {"/tags", "array has more than 3 items"}},
+            {R"({"id": 1, "name": "bob", "a/b~": true})",
+             {"/a~1b~0", "no value is allowed here"}}};
+
+        try {
+            const auto schema =
+                json::schema::compile(json::deserialize(userSchema));
+            for (const auto& [content, expected] : cases) {
+                // the same violation is found in the tree and while parsing
+                const auto tree = schema.validate(json::deserialize(content));
+                const auto parsed = parse_violation(schema, content);
+                if (!tree || !parsed || tree->path != expected.path ||
+                    tree->message != expected.message ||
+                    parsed->path != expected.path ||
+                    parsed->message != expected.message) {
+                    log_info(content.c_str(), __LINE__);
+                    return TEST_ERROR();
+                }
+            }
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // recursive references and combinators
+        const std::string tree{R"({
+            "$defs": {
+                "label": {"anyOf": [{"type": "string"}, {"type": "integer"}]}
+            },
+            "type": "object",
+            "properties": {
+                "label": {"$ref": "#/$defs/label"},
+                "kind": {"oneOf": [{"const": "leaf"}, {"const": "node"}]},
+                "meta": {"not": {"required": ["secret"]},
+                         "enum": [{"a": 1}, {"a": 2, "secret": true}]},
+                "children": {"type": "array", "items": {"$ref": "#"}}
+            }
+        })"};
+
+        const std::pair<std::string, std::string> cases[]{
+            {R"({"label": "root", "kind": "node", "children": [)"
+             R"({"label": 1, "kind": "leaf", "meta": {"a": 1.0}}]})",
+             ""},
+            {R"({"children": [{"children": [{"label": true}]}]})",
+             "/children/0/children/0/label"},
+            {R"({"children": [{"kind": "tree"}]})", "/children/0/kind"},
+            {R"({"meta": {"a": 3}})", "/meta"},
+            {R"({"meta": {"a": 2, "secret": true}})", "/meta"}};
+
+        try {
+            const auto schema = json::schema::compile(json::deserialize(tree));
+            for (const auto& [content, path] : cases) {
+                const auto error = schema.validate(json::deserialize(content));
+                const auto parsed = parse_violation(schema, content);
+                if (path.empty() ? error || parsed
+                                 : !error || !parsed || error->path != path ||
+                                       parsed->path != path) {
+                    log_info(content.c_str(), __LINE__);
+                    return TEST_ERROR();
+                }
+            }
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // integers are compared exactly, beyond the precision of a double
+        const std::string numbers{R"({
+            "type": "object",
+            "properties": {
+                "big": {"enum": [18446744073709551615]},
+                "low": {"const": -9223372036854775808},
+                "max": {"maximum": 9007199254740992},
+                "min": {"exclusiveMinimum": 9007199254740992}
+            }
+        })"};
+
+        const std::pair<std::string, std::string> cases[]{
+            {R"({"big": 18446744073709551615, "low": -9223372036854775808,)"
+             R"( "max": 9007199254740992, "min": 9007199254740993})",
+             ""},
+            {R"({"big": 18446744073709551614})", "/big"},
+            {R"({"low": -9223372036854775807})", "/low"},
+            {R"({"max": 9007199254740993})", "/max"},
+            {R"({"min": 9007199254740992})", "/min"},
+            {R"({"max": 9007199254740994.0})", "/max"}};
+
+        try {
+            const auto schema =
+                json::schema::compile(json::deserialize(numbers));
+            for (const auto& [content, path] : cases) {
+                const auto error = schema.validate(json::deserialize(content));
+                const auto parsed = parse_violation(schema, content);
+                if (path.empty() ? error || parsed
+                                 : !error || !parsed || error->path != path ||
+                                       parsed->path != path) {
+                    log_info(content.c_str(), __LINE__);
+                    return TEST_ERROR();
+                }
+            }
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"({"id": 1, "name": "bob", "tags": ["ok", "fine", "denied"]})"};
+
+        try {
+            // streamed in small chunks, no tree is ever built
+            const auto schema =
+                json::schema::compile(json::deserialize(userSchema));
+            json::schema_checker checker{schema};
+            json::reader reader{};
+            for (std::size_t idx{0}; idx < content.size(); idx += 5)
+                reader.feed(std::string_view{content}.substr(idx, 5), checker);
+            reader.finish(checker);
+        } catch (const json::schema_violation_exception& ex) {
+            if (ex.error().path != "/tags/2") return TEST_ERROR();
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        const std::string invalid[]{
+            R"({"uniqueItems": true})", R"({"type": "text"})",
+            R"({"pattern": "^[a-z]+$"})", R"({"$ref": "#/$defs/missing"})",
+            R"({"$ref": "other.json"})", R"({"minLength": -1})",
+            R"({"$ref": "#"})", R"({"anyOf": [{"$ref": "#"}]})",
+            R"({"$defs": {"a": {"$ref": "#/$defs/a"}}, "$ref": "#/$defs/a"})",
+            R"({"properties": {"x": {"$ref": "#/$defs/a"}}, "$defs": {)"
+            R"( "a": {"not": {"$ref": "#/$defs/b"}},)"
+            R"( "b": {"allOf": [{"$ref": "#/$defs/a"}]}}})"};
+
+        for (const auto& content : invalid) {
+            try {
+                (void)json::schema::compile(json::deserialize(content));
+                return TEST_ERROR();
+            } catch (const json::invalid_schema_exception&) {
+            } catch (const std::exception& ex) {
+                log_exception(ex.what());
+                return TEST_ERROR();
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        // checks stay linear in the length of the strings they run on
+        const std::string content{
+            std::format(R"(["{}", "{}"])", std::string(1 << 22, 'a'),
+                        std::string(1 << 22, 'b'))};
+
+        try {
+            const auto schema = json::schema::compile(json::deserialize(
+                R"({"items": {"type": "string", "minLength": 1,)"
+                R"( "maxLength": 4194304}, "maxItems": 2})"));
+            const auto root = json::deserialize(content, {.schema = &schema});
+            if (schema.validate(root) || root.at(1).string().size() != 1 << 22)
+                return TEST_ERROR();
+
+            const auto shorter = json::schema::compile(json::deserialize(
+                R"({"items": {"type": "string", "maxLength": 4194303}})"));
+            const auto error = parse_violation(shorter, content);
+            if (!error || error->path != "/0") return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
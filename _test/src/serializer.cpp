@@ -0,0 +1,145 @@
+#include "../../build/include/parser.hpp"
+#include "../../build/include/serializer.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const json::node node{json::object{
+            {"null", json::node()},
+            {"bool", json::node{json::array{json::node{true}, json::node{false}}}},
+            {"int", json::node{-69}},
+            {"float", json::node{420.5f}},
+            {"string", json::node{std::string{"test string"}}}}};
+
+        const auto content = json::serialize(node);
+        if (content != R"({"null":null,"bool":[true,false],"int":-69,)"
+                       R"("float":420.5,"string":"test string"})")
+            return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        const json::node node{json::object{
+            {"empty", json::node{json::array{}}},
+            {"list", json::node{json::array{json::node{1}, json::node{2}}}}}};
+
+        const auto content = json::serialize(node, {.indent = 2});
+        if (content != "{\n"
+                       "  \"empty\": [],\n"
+                       "  \"list\": [\n"
+                       "    1,\n"
+                       "    2\n"
+                       "  ]\n"
+                       "}")
+            return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        const json::node node{json::array{json::node{std::string{
+            "quote \" backslash \\ newline \n tab \t bell \x07 long "
+            "enough to take the vectorized path"}}}};
+
+        if (json::serialize(node) !=
+            R"(["quote \" backslash \\ newline \n tab \t bell \u0007 long )"
+            R"(enough to take the vectorized path"])")
+            return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        const json::node node{
+            json::array{json::node{420.}, json::node{1e10}, json::node{0.1}}};
+
+        try {
+            const auto content = json::serialize(node);
+            if (content != "[420.0,1e+10,0.1]") return TEST_ERROR();
+
+            const auto parsed = json::deserialize(content);
+            if (parsed.at(0).tag() != json::node_tag::JsonFloat ||
+                parsed.at(2).value<double>() != 0.1)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"({"list":[{"dt":1661857200,"temp":{"day":299.66,"max":299.66}}],)"
+            R"("name":"weather"})"};
+
+        try {
+            const auto node = json::deserialize(content);
+            std::string buffer{"prefix "};
+            json::serialize(node, buffer);
+            if (buffer != "prefix " + content) return TEST_ERROR();
+
+            std::string out{};
+            json::serialize(node, std::back_inserter(out));
+            if (out != content) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"([-9223372036854775808,18446744073709551615,)"
+            R"(1.7976931348623157e+308,5e-324,0.30000000000000004,)"
+            R"(123456789012345678901234567890,3.14159265358979323846264])"};
+
+        try {
+            const auto node =
+                json::deserialize(content, {.raw_numbers = true});
+            if (json::serialize(node) != content) return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "../../build/include/parser.hpp"
+#include "../../build/include/serializer.hpp"
+#include "../../build/include/shared.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const std::string content{
+            R"({"null":null,"bool":[true,false],"numbers":{"int":-69,)"
+            R"("float":420.5},"string":"test string"})"};
+
+        try {
+            const json::shared_node root{json::deserialize(content)};
+            if (root.tag() != json::node_tag::JsonObject || root.size() != 4)
+                return TEST_ERROR();
+            if (root.field("null").tag() != json::node_tag::JsonNull ||
+                !root.field("bool").at(0).value<bool>() ||
+                root.field("numbers").field("int").value<int>() != -69 ||
+                root.field("numbers").field("float").value<float>() !=
+                    420.5f ||
+                root.field("string").string() != "test string")
+                return TEST_ERROR();
+            if (json::serialize(root.to_node()) != content)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"({"server":{"host":"localhost","port":80},)"
+            R"("routes":[{"path":"/"},{"path":"/api"}],"limits":{"rate":10}})"};
+
+        try {
+            const json::shared_node config{json::deserialize(content)};
+            auto copy{config};
+            if (!copy.shares(config)) return TEST_ERROR();
+
+            // only the containers on the path are copied
+            copy.field("server").field("port") = 8080;
+            copy.field("routes").at(1)["auth"] = true;
+            const auto& routes{config.field("routes")};
+            if (copy.shares(config) ||
+                copy.field("server").shares(config.field("server")) ||
+                !copy.field("limits").shares(config.field("limits")) ||
+                !copy.field("routes").at(0).shares(routes.at(0)))
+                return TEST_ERROR();
+
+            if (json::serialize(config.to_node()) != content ||
+                copy.field("server").field("port").value<int>() != 8080 ||
+                !copy.field("routes").at(1).field("auth").value<bool>())
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            json::shared_node root{json::deserialize(R"({"list":[1]})")};
+            // a handle owning its storage alone is edited in place
+            const auto* list{&root.field("list")};
+            root.field("list").push_back(2);
+            if (&root.field("list") != list || list->size() != 2)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            // larger objects are searched through their sorted keys
+            json::shared_node root{json::object{}};
+            for (int i{19}; i >= 0; i--)
+                root[std::format("key{}", i)] = i;
+            const auto before{root};
+            if (!root.erase("key7") || root.erase("key7") ||
+                root.contains("key7") || !before.contains("key7"))
+                return TEST_ERROR();
+            for (int i{0}; i < 20; i++)
+                if (i != 7 &&
+                    root.field(std::format("key{}", i)).value<int>() != i)
+                    return TEST_ERROR();
+            if (root.size() != 19 || before.size() != 20 ||
+                root.fields().front().first != "key19")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const json::shared_node root{json::deserialize(R"({"first": [1]})")};
+        try {
+            const auto& _ = root.at(0);
+        } catch (const json::node_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        json::shared_node root{json::deserialize(R"({"first": [1]})")};
+        try {
+            auto& _ = root.field("second");
+        } catch (const std::out_of_range&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        // objects past the linear scan limit keep every key findable
+        const std::string content{
+            R"({"k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5,)"
+            R"( "k6": 6, "k7": 7, "k8": 8, "k9": 9})"};
+
+        try {
+            const json::shared_node shared{json::deserialize(content)};
+            const auto root = shared.to_node();
+            if (root.fields().size() != 10 || !root.fields().contains("k0") ||
+                root.field("k8").value<int>() != 8)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "../../build/include/simd.hpp"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static auto naive_index(std::string_view source) -> std::vector<std::uint32_t> {
+    std::vector<std::uint32_t> retval{};
+    bool inString{false};
+    bool boundary{true};
+    for (std::uint32_t i{0}; i < source.size(); i++) {
+        const auto ch = source[i];
+        if (inString) {
+            if (ch == '\\')
+                i++;
+            else if (ch == '"') {
+                inString = false;
+                boundary = true;
+            }
+            continue;
+        }
+
+        const auto isOp = std::string_view{"[]{}:,"}.find(ch) !=
+                          std::string_view::npos;
+        const auto isSpace = std::string_view{" \t\n\r"}.find(ch) !=
+                             std::string_view::npos;
+        if (ch == '"') {
+            retval.push_back(i);
+            inString = true;
+            boundary = false;
+        } else if (isOp) {
+            retval.push_back(i);
+            boundary = true;
+        } else if (isSpace) {
+            boundary = true;
+        } else {
+            if (boundary) retval.push_back(i);
+            boundary = false;
+        }
+    }
+    return retval;
+}
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        std::vector<std::uint32_t> index{};
+        json::build_structural_index(R"({"a": [1, true, "x"]})", index);
+        const std::vector<std::uint32_t> expected{0, 1, 4, 6, 7, 8, 10, 14,
+                                                  16, 19, 20};
+        if (index != expected) return TEST_ERROR();
+        return TEST_OK();
+    },
+    [] {
+        // strings, escapes and scalars straddling the 64 bytes blocks
+        std::string content{"["};
+        for (auto i = 0; i < 200; i++) {
+            content += std::string(i % 7, ' ');
+            content += i % 3 == 0   ? R"("a\"b\\",)"
+                       : i % 3 == 1 ? "-12.5e3 ,"
+                                    : R"({"k\\\"": null},)";
+        }
+        content += "1]";
+
+        for (std::size_t offset = 0; offset < 64; offset++) {
+            const auto source = std::string(offset, ' ') + content;
+            std::vector<std::uint32_t> index{};
+            json::build_structural_index(source, index);
+            if (index != naive_index(source)) return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        std::vector<std::uint32_t> index{1, 2, 3};
+        json::build_structural_index("", index);
+        if (!index.empty()) return TEST_ERROR();
+        return TEST_OK();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "../../build/include/parser.hpp"
+#include "../../build/include/stats.hpp"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static std::vector<std::function<bool()>> tests{
+#ifdef JSON_PARSE_STATS
+    [] {
+        const std::string content{
+            R"({"list": [1, 2.5, "a string too long for the inline buffer",)"
+            R"( null, true], "nested": {"deep": [[1]]}})"};
+
+        try {
+            json::parse_stats stats{};
+            const auto _ = json::deserialize(content, {.stats = &stats});
+            if (stats.bytes != content.size() || stats.max_depth != 4)
+                return TEST_ERROR();
+            if (stats.count(json::node_tag::JsonInt) != 2 ||
+                stats.count(json::node_tag::JsonFloat) != 1 ||
+                stats.count(json::node_tag::JsonString) != 1 ||
+                stats.count(json::node_tag::JsonNull) != 1 ||
+                stats.count(json::node_tag::JsonBool) != 1 ||
+                stats.count(json::node_tag::JsonArray) != 3 ||
+                stats.count(json::node_tag::JsonObject) != 2)
+                return TEST_ERROR();
+            // the long string and the growth of every container
+            if (stats.allocations < 6 || stats.allocated_bytes == 0)
+                return TEST_ERROR();
+            if ((stats.index_time + stats.scan_time + stats.number_time +
+                 stats.build_time)
+                    .count() == 0)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        try {
+            // counters add up over every parse they are passed to
+            json::parse_stats stats{};
+            const auto first = json::deserialize_file(
+                "/home/giorgi/git/personal/cppjson/_test/data/weather.json",
+                {.borrow_strings = true, .stats = &stats});
+            const auto bytes{stats.bytes};
+            const auto objects{stats.count(json::node_tag::JsonObject)};
+            const auto second = json::deserialize(R"({"a": {}})",
+                                                  {.stats = &stats});
+
+            if (bytes == 0 || stats.bytes != bytes + 9 ||
+                stats.count(json::node_tag::JsonObject) != objects + 2)
+                return TEST_ERROR();
+            // borrowing is turned off, the mapping is gone by now
+            if (first.field("city").field("name").string() != "Zocca")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // the key index of objects past the linear scan limit is counted
+        try {
+            json::parse_stats small{};
+            const auto _ = json::deserialize(
+                R"({"a": 1, "b": 2, "c": 3, "d": 4, "e": 5, "f": 6, "g": 7,)"
+                R"( "h": 8})",
+                {.stats = &small});
+            json::parse_stats indexed{};
+            const auto __ = json::deserialize(
+                R"({"a": 1, "b": 2, "c": 3, "d": 4, "e": 5, "f": 6, "g": 7,)"
+                R"( "h": 8, "i": 9})",
+                {.stats = &indexed});
+            // one more entries buffer, and the index
+            if (indexed.allocations < small.allocations + 2)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+#else
+    [] {
+        // compiled out, the counters are left untouched
+        try {
+            json::parse_stats stats{};
+            const auto _ =
+                json::deserialize(R"({"a": [1]})", {.stats = &stats});
+            if (stats.bytes != 0 || stats.count(json::node_tag::JsonInt) != 0)
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+#endif
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "../../build/include/tape.hpp"
+
+#include <sys/types.h>
+
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+auto log_info(const char* msg, uint line) noexcept -> void {
+    std::cout << std::format("[?] {}:{}:\tinfo: {}", __FILE__, line, msg)
+              << std::endl;
+}
+
+auto log_exception(const char* msg) noexcept -> void {
+    std::cout << "[!] fatal: unhandled exception: " << std::quoted(msg)
+              << std::endl;
+}
+
+#define TEST_OK() (log_info("test \033[1;32mOK\033[0m", __LINE__), true)
+#define TEST_ERROR() (log_info("test \033[1;31mFAILED\033[0m", __LINE__), false)
+
+static std::vector<std::function<bool()>> tests{
+    [] {
+        const std::string content{
+            R"({
+                "null": null,
+                "bool": [true, false],
+                "numbers": {
+                    "int": 69,
+                    "float": 420.5
+                },
+                "string": "test string"
+        })"};
+
+        try {
+            const auto tape = json::deserialize_tape(content);
+            const auto root = tape.root();
+            if (root.tag() != json::node_tag::JsonObject || root.size() != 4)
+                return TEST_ERROR();
+            if (root.field("null").tag() != json::node_tag::JsonNull)
+                return TEST_ERROR();
+            const auto boolValues = root.field("bool");
+            if (boolValues.size() != 2 || !boolValues.at(0).value<bool>() ||
+                boolValues.at(1).value<bool>())
+                return TEST_ERROR();
+            const auto numberValues = root.field("numbers");
+            if (numberValues.field("int").value<int>() != 69 ||
+                numberValues.field("float").value<float>() != 420.5f)
+                return TEST_ERROR();
+            if (root.field("string").value<std::string_view>() !=
+                "test string")
+                return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        const std::string content{
+            R"([[1, [2, 3]], {"a": {"b": []}}, 4.5, "last"])"};
+
+        try {
+            const auto tape = json::deserialize_tape(content);
+            const auto root = tape.root();
+            if (root.size() != 4) return TEST_ERROR();
+            if (root.at(0).at(1).at(1).value<int>() != 3) return TEST_ERROR();
+            if (root.at(1).field("a").field("b").size() != 0)
+                return TEST_ERROR();
+            if (root.at(2).value<float>() != 4.5f) return TEST_ERROR();
+            if (root.at(3).value<std::string>() != "last") return TEST_ERROR();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_OK();
+    },
+    [] {
+        // narrowing is range checked like `node::value<int>`
+        const auto tape = json::deserialize_tape(
+            "[2147483647, 3000000000, -3000000000, 18446744073709551615]");
+        const auto root = tape.root();
+        if (root.at(0).value<int>() != 2147483647) return TEST_ERROR();
+        for (uint idx{1}; idx < root.size(); idx++) {
+            try {
+                const auto _ = root.at(idx).value<int>();
+                return TEST_ERROR();
+            } catch (const json::node_exception&) {
+            }
+        }
+        return TEST_OK();
+    },
+    [] {
+        const auto tape = json::deserialize_tape(R"({"first": [1]})");
+        try {
+            const auto _ = tape.root().at(0);
+        } catch (const json::node_exception&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        const auto tape = json::deserialize_tape(R"({"first": [1]})");
+        try {
+            const auto _ = tape.root().field("first").at(1);
+        } catch (const std::out_of_range&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+    [] {
+        const auto tape = json::deserialize_tape(R"({"first": [1]})");
+        try {
+            const auto _ = tape.root().field("second");
+        } catch (const std::out_of_range&) {
+            return TEST_OK();
+        } catch (const std::exception& ex) {
+            log_exception(ex.what());
+            return TEST_ERROR();
+        }
+        return TEST_ERROR();
+    },
+};
+
+auto main(int argc, char** argv) -> int {
+    if (argc > 1) throw std::invalid_argument("unexpected parameters provided");
+
+    std::cout << "----------[ Running tests ]----------" << std::endl;
+
+    uint errorCount{0};
+    for (const auto& test : tests) {
+        errorCount += (uint)!test();
+    }
+
+    std::cout << "-------------------------------------" << std::endl
+              << "Test suite report: " << std::quoted(*argv) << std::endl
+              << "  Completed:  " << tests.size() << std::endl
+              << "  Errors:     " << errorCount
+              << std::format(" ({:.2f}%)", errorCount * 100.f / tests.size())
+              << std::endl
+              << std::endl;
+
+    return 0;
+}
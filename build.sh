@@ -14,7 +14,7 @@ function do_build() {
         filename="$(basename $file)"
         filename="${filename%.*}"
         echo "[?] info: building file: $file"
-        g++ -Wall -Wextra -std=c++23 -c -$OPT_LEVEL -o obj/$filename.o $file
+        g++ -Wall -Wextra -std=c++23 $CXXFLAGS -c -$OPT_LEVEL -o obj/$filename.o $file
     done
 
     # linking
@@ -48,6 +48,23 @@ function do_tests() {
     cd -
 }
 
+function do_bench() {
+    if [ ! -d _bench ]; then
+        echo '[!] fatal: cannot find folder `_bench`'
+        exit 1
+    fi
+
+    # build benchmarks
+    cd _bench
+    ./build.sh
+
+    # run benchmarks, one json line per measurement
+    for file in build/*; do
+        $file
+    done
+    cd -
+}
+
 function do_clean() {
     # remove targets
     [ -d obj ] && rm -rf obj
@@ -86,6 +103,16 @@ else
             do_tests
             ;;
 
+        --bench)
+            OPT_LEVEL=O2
+            echo '[?] info: DEBUG set to false'
+            echo '[?] info: building source'
+            do_build
+            echo '[?] info: building benchmarks'
+            echo '--------------------'
+            do_bench
+            ;;
+
         *)
             echo "[!] error: unknown option provided: $1"
             exit 1
@@ -0,0 +1,80 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+/* arena implementation */
+namespace json {
+arena::arena(std::size_t chunkSize) noexcept
+    : _chunkSize(std::max<std::size_t>(chunkSize, 64)) {}
+
+arena::~arena() {
+    release();
+}
+
+auto arena::reset() noexcept -> void {
+    _current = 0;
+    _offset = 0;
+    _used = 0;
+}
+
+auto arena::release() noexcept -> void {
+    for (const auto& chunk : _chunks)
+        ::operator delete(chunk.data, std::align_val_t{alignof(std::max_align_t)});
+
+    _chunks.clear();
+    reset();
+}
+
+auto arena::used() const noexcept -> std::size_t {
+    return _used;
+}
+
+auto arena::capacity() const noexcept -> std::size_t {
+    std::size_t retval{0};
+    for (const auto& chunk : _chunks) retval += chunk.size;
+    return retval;
+}
+
+auto arena::do_allocate(std::size_t bytes, std::size_t alignment) -> void* {
+    const auto fits = [&](const chunk& chunk, std::size_t offset) {
+        const auto addr{reinterpret_cast<std::uintptr_t>(chunk.data) + offset};
+        const auto padding{(alignment - addr % alignment) % alignment};
+        return offset + padding + bytes <= chunk.size
+                   ? static_cast<std::ptrdiff_t>(padding)
+                   : -1;
+    };
+
+    while (_current < _chunks.size()) {
+        if (const auto padding = fits(_chunks[_current], _offset);
+            padding >= 0) {
+            auto ptr{_chunks[_current].data + _offset + padding};
+            _offset += static_cast<std::size_t>(padding) + bytes;
+            _used += bytes;
+            return ptr;
+        }
+
+        // chunks retained from a previous cycle are reused in order
+        _current++;
+        _offset = 0;
+    }
+
+    const auto size{std::max(_chunkSize, bytes + alignment)};
+    auto data{static_cast<std::byte*>(::operator new(
+        size, std::align_val_t{alignof(std::max_align_t)}))};
+    _chunks.push_back({data, size});
+    _chunkSize = std::min(_chunkSize * 2, std::size_t{16} << 20);
+
+    _current = _chunks.size() - 1;
+    _offset = 0;
+    return do_allocate(bytes, alignment);
+}
+
+auto arena::do_deallocate(void*, std::size_t, std::size_t) -> void {}
+
+auto arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    -> bool {
+    return this == &other;
+}
+}  // namespace json
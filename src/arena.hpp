@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace json {
+// bump allocator handing out memory from retained chunks, deallocation is a
+// no-op and the whole region is rewound at once by `reset`
+class arena final : public std::pmr::memory_resource {
+   public:
+    explicit arena(std::size_t chunkSize = 64 * 1024) noexcept;
+    arena(const arena&) = delete;
+    ~arena();
+
+    auto operator=(const arena&) -> arena& = delete;
+
+    // every node allocated from the arena must be destroyed before rewinding
+    auto reset() noexcept -> void;
+    auto release() noexcept -> void;
+
+    [[nodiscard]] auto used() const noexcept -> std::size_t;
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+
+   private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment)
+        -> void* override;
+    auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+        -> void override;
+    auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+        -> bool override;
+
+   private:
+    struct chunk {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    std::vector<chunk> _chunks{};
+    std::size_t _current{0};
+    std::size_t _offset{0};
+    std::size_t _used{0};
+    std::size_t _chunkSize;
+};
+}  // namespace json
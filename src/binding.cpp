@@ -0,0 +1,24 @@
+#include "binding.hpp"
+
+#include <format>
+
+namespace json {
+auto skip_value(reader& reader, event_tag event) -> void {
+    std::size_t open{0};
+    while (true) {
+        if (event == event_tag::ArrayStart || event == event_tag::ObjectStart)
+            open++;
+        else if (event == event_tag::ArrayEnd || event == event_tag::ObjectEnd)
+            open--;
+
+        if (open == 0) return;
+        event = reader.next();
+    }
+}
+
+auto throw_mismatch(const reader& reader, const char* expected) -> void {
+    throw invalid_json_exception(std::format(
+        "unexpected value at position {}: expected {}", reader.position(),
+        expected));
+}
+}  // namespace json
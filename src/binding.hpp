@@ -0,0 +1,232 @@
+#pragma once
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "reader.hpp"
+#include "serializer.hpp"
+#include "simd.hpp"
+
+namespace json {
+// a data member of `Owner` stored under the key `name`
+template <class Owner, class Tp>
+struct member {
+    std::string_view name;
+    Tp Owner::*pointer;
+};
+
+// specialized for every bound struct with a `fields` tuple of members
+template <class Tp>
+struct binding;
+
+// JSON_BIND(point, json::member{"x", &point::x}, json::member{"y", &point::y});
+#define JSON_BIND(Type, ...)                                     \
+    template <>                                                  \
+    struct json::binding<Type> {                                 \
+        static constexpr auto fields = std::tuple{__VA_ARGS__}; \
+    }
+
+template <class Tp>
+concept bound = requires { binding<Tp>::fields; };
+
+template <class Tp>
+struct is_bindable
+    : std::bool_constant<bound<Tp> || std::is_arithmetic_v<Tp> ||
+                         std::is_same_v<std::string, Tp> ||
+                         std::is_same_v<std::string_view, Tp>> {};
+
+template <class Tp>
+struct is_bindable<std::optional<Tp>> : is_bindable<Tp> {};
+
+template <class Tp, class Alloc>
+struct is_bindable<std::vector<Tp, Alloc>> : is_bindable<Tp> {};
+
+// types decoded straight from the reader events, without building nodes
+template <class Tp>
+concept bindable = is_bindable<Tp>::value;
+
+// consumes the value starting with `event`, nested containers included
+auto skip_value(reader& reader, event_tag event) -> void;
+[[noreturn]] auto throw_mismatch(const reader& reader, const char* expected)
+    -> void;
+
+template <bindable Tp>
+auto decode_value(reader& reader, event_tag event, Tp& out) -> void;
+
+template <bindable Tp>
+auto decode_number(const reader& reader, event_tag event, Tp& out) -> void {
+    if (event != event_tag::JsonNumber) throw_mismatch(reader, "number");
+
+    if constexpr (std::is_floating_point_v<Tp>) {
+        // overflows are rejected like in `node_builder`, underflows are
+        // kept as zero; narrower types are range checked before converting
+        const auto number{reader.number()};
+        const auto real{std::get_if<double>(&number)};
+        if (real && std::isinf(*real))
+            throw_mismatch(reader, "number in range");
+        if constexpr (std::numeric_limits<Tp>::max() <
+                      std::numeric_limits<double>::max())
+            if (real && std::abs(*real) > std::numeric_limits<Tp>::max())
+                throw_mismatch(reader, "number in range");
+        std::visit([&](auto value) { out = static_cast<Tp>(value); }, number);
+    } else {
+        const auto fits{std::visit(
+            [&](auto value) {
+                if constexpr (std::is_integral_v<decltype(value)>) {
+                    if (!std::in_range<Tp>(value)) return false;
+                    out = static_cast<Tp>(value);
+                    return true;
+                } else {
+                    return false;
+                }
+            },
+            reader.number())};
+        if (!fits) throw_mismatch(reader, "integer in range");
+    }
+}
+
+template <bound Tp>
+auto decode_object(reader& reader, event_tag event, Tp& out) -> void {
+    if (event != event_tag::ObjectStart) throw_mismatch(reader, "object");
+
+    while ((event = reader.next()) != event_tag::ObjectEnd) {
+        const auto key{reader.string()};
+        const auto found{std::apply(
+            [&](const auto&... fields) {
+                return ((fields.name == key &&
+                         (decode_value(reader, reader.next(),
+                                       out.*fields.pointer),
+                          true)) ||
+                        ...);
+            },
+            binding<Tp>::fields)};
+
+        // unknown keys are not part of the schema
+        if (!found) skip_value(reader, reader.next());
+    }
+}
+
+template <bindable Tp>
+auto decode_value(reader& reader, event_tag event, Tp& out) -> void {
+    if constexpr (std::is_same_v<bool, Tp>) {
+        if (event != event_tag::JsonBool) throw_mismatch(reader, "boolean");
+        out = reader.boolean();
+    } else if constexpr (std::is_arithmetic_v<Tp>) {
+        decode_number(reader, event, out);
+    } else if constexpr (std::is_same_v<std::string, Tp> ||
+                         std::is_same_v<std::string_view, Tp>) {
+        if (event != event_tag::JsonString) throw_mismatch(reader, "string");
+        // views borrow from the content, decoded escapes live in the reader
+        if (std::is_same_v<std::string_view, Tp> && reader.escaped())
+            throw_mismatch(reader, "string without escapes");
+        out = reader.string();
+    } else if constexpr (bound<Tp>) {
+        decode_object(reader, event, out);
+    } else if constexpr (requires { out.has_value(); }) {
+        if (event == event_tag::JsonNull)
+            out.reset();
+        else
+            decode_value(reader, event, out.emplace());
+    } else {
+        if (event != event_tag::ArrayStart) throw_mismatch(reader, "array");
+
+        out.clear();
+        while ((event = reader.next()) != event_tag::ArrayEnd)
+            decode_value(reader, event, out.emplace_back());
+    }
+}
+
+// decodes `content` into `out` without an intermediate node tree, fields
+// missing from the document keep their value
+template <bindable Tp>
+auto deserialize_into(std::string_view content, Tp& out) -> void {
+    std::vector<std::uint32_t> index{};
+    auto reader{build_structural_index(content, index)
+                    ? json::reader{content, index}
+                    : json::reader{content}};
+
+    decode_value(reader, reader.next(), out);
+    if (reader.next() != event_tag::DocumentEnd)
+        throw std::logic_error("unreachable: the root value ends the document");
+}
+
+template <bindable Tp>
+[[nodiscard]] auto deserialize_as(std::string_view content) -> Tp {
+    Tp retval{};
+    deserialize_into(content, retval);
+    return retval;
+}
+
+template <bindable Tp>
+auto encode_value(std::string& out, const Tp& value,
+                  const serialize_options& options, uint depth) -> void {
+    if constexpr (std::is_same_v<bool, Tp>) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_floating_point_v<Tp>) {
+        write_float(out, value);
+    } else if constexpr (std::is_arithmetic_v<Tp>) {
+        char buf[32];
+        const auto res{std::to_chars(buf, buf + sizeof(buf), value)};
+        out.append(buf, res.ptr);
+    } else if constexpr (std::is_same_v<std::string, Tp> ||
+                         std::is_same_v<std::string_view, Tp>) {
+        write_string(out, value);
+    } else if constexpr (bound<Tp>) {
+        out += '{';
+        bool first{true};
+        std::apply(
+            [&](const auto&... fields) {
+                ((out += first ? "" : ",", first = false,
+                  write_newline(out, options, depth + 1),
+                  write_string(out, fields.name),
+                  out += options.indent == 0 ? ":" : ": ",
+                  encode_value(out, value.*fields.pointer, options,
+                               depth + 1)),
+                 ...);
+            },
+            binding<Tp>::fields);
+        if (!first) write_newline(out, options, depth);
+        out += '}';
+    } else if constexpr (requires { value.has_value(); }) {
+        if (value)
+            encode_value(out, *value, options, depth);
+        else
+            out += "null";
+    } else {
+        out += '[';
+        for (auto it{value.begin()}; it != value.end(); it++) {
+            if (it != value.begin()) out += ',';
+            write_newline(out, options, depth + 1);
+            encode_value(out, *it, options, depth + 1);
+        }
+        if (!value.empty()) write_newline(out, options, depth);
+        out += ']';
+    }
+}
+
+template <bindable Tp>
+auto serialize(const Tp& value, std::string& buffer,
+               const serialize_options& options = {}) -> void {
+    encode_value(buffer, value, options, 0);
+}
+
+template <bindable Tp>
+[[nodiscard]] auto serialize(const Tp& value,
+                             const serialize_options& options = {})
+    -> std::string {
+    std::string retval{};
+    encode_value(retval, value, options, 0);
+    return retval;
+}
+}  // namespace json
@@ -0,0 +1,653 @@
+#include "cbor.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "lexer.hpp"
+
+namespace json {
+constexpr std::uint8_t majorUnsigned{0};
+constexpr std::uint8_t majorNegative{1};
+constexpr std::uint8_t majorBytes{2};
+constexpr std::uint8_t majorText{3};
+constexpr std::uint8_t majorArray{4};
+constexpr std::uint8_t majorMap{5};
+constexpr std::uint8_t majorTag{6};
+constexpr std::uint8_t majorSimple{7};
+
+constexpr std::uint64_t tagPositiveBignum{2};
+constexpr std::uint64_t tagNegativeBignum{3};
+constexpr std::uint64_t tagDecimalFraction{4};
+constexpr std::uint64_t tagStringReference{25};
+constexpr std::uint64_t tagStringNamespace{256};
+
+constexpr std::uint8_t indefinite{31};
+constexpr std::uint8_t breakCode{0xFF};
+
+// strings shorter than this are never referenced, as the reference would
+// not be shorter (stringref specification)
+auto min_reference_length(std::size_t index) noexcept -> std::size_t {
+    if (index < 24) return 3;
+    if (index < 256) return 4;
+    if (index < 65536) return 5;
+    if (index < 4294967296) return 7;
+    return 11;
+}
+
+/* decimal strings, for bignums */
+auto decimal_to_bytes(std::string_view digits) -> std::string {
+    std::string number{digits};
+    std::string retval{};
+    while (!number.empty() && number != "0") {
+        std::string quotient{};
+        unsigned remainder{0};
+        for (const auto ch : number) {
+            const auto value{remainder * 10 + static_cast<unsigned>(ch - '0')};
+            if (!quotient.empty() || value >= 256)
+                quotient += static_cast<char>('0' + value / 256);
+            remainder = value % 256;
+        }
+        retval += static_cast<char>(remainder);
+        number = std::move(quotient);
+    }
+    std::reverse(retval.begin(), retval.end());
+    return retval;
+}
+
+auto bytes_to_decimal(std::string_view bytes) -> std::string {
+    // least significant digit first
+    std::vector<std::uint8_t> digits{};
+    for (const auto byte : bytes) {
+        auto carry{static_cast<unsigned>(static_cast<std::uint8_t>(byte))};
+        for (auto& digit : digits) {
+            const auto value{digit * 256u + carry};
+            digit = static_cast<std::uint8_t>(value % 10);
+            carry = value / 10;
+        }
+        for (; carry != 0; carry /= 10)
+            digits.push_back(static_cast<std::uint8_t>(carry % 10));
+    }
+
+    std::string retval{};
+    for (auto it{digits.rbegin()}; it != digits.rend(); it++)
+        retval += static_cast<char>('0' + *it);
+    return retval.empty() ? "0" : retval;
+}
+
+// negative bignums store `-1 - value`, so magnitudes are shifted by one
+auto increment(std::string digits) -> std::string {
+    for (auto it{digits.rbegin()}; it != digits.rend(); it++) {
+        if (*it != '9') {
+            (*it)++;
+            return digits;
+        }
+        *it = '0';
+    }
+    return '1' + digits;
+}
+
+auto decrement(std::string digits) -> std::string {
+    for (auto it{digits.rbegin()}; it != digits.rend(); it++) {
+        if (*it != '0') {
+            (*it)--;
+            break;
+        }
+        *it = '9';
+    }
+    const auto first{digits.find_first_not_of('0')};
+    return first == std::string::npos ? "0" : digits.substr(first);
+}
+
+/* encoder */
+class cbor_encoder final {
+   public:
+    cbor_encoder(std::string& out, const cbor_options& options)
+        : _out(out), _options(options) {}
+
+    auto encode(const node& value) -> void {
+        if (_options.key_dictionary) _head(majorTag, tagStringNamespace);
+        _value(value);
+    }
+
+   private:
+    auto _head(std::uint8_t major, std::uint64_t argument) -> void {
+        const auto type{static_cast<char>(major << 5)};
+        if (argument < 24) {
+            _out += static_cast<char>(type | argument);
+        } else if (argument <= 0xFF) {
+            _out += static_cast<char>(type | 24);
+            _out += static_cast<char>(argument);
+        } else if (argument <= 0xFFFF) {
+            _out += static_cast<char>(type | 25);
+            _big_endian(argument, 2);
+        } else if (argument <= 0xFFFFFFFF) {
+            _out += static_cast<char>(type | 26);
+            _big_endian(argument, 4);
+        } else {
+            _out += static_cast<char>(type | 27);
+            _big_endian(argument, 8);
+        }
+    }
+
+    auto _big_endian(std::uint64_t value, uint bytes) -> void {
+        for (auto i{bytes}; i > 0; i--)
+            _out += static_cast<char>(value >> (i - 1) * 8);
+    }
+
+    auto _string(std::string_view value) -> void {
+        if (_options.key_dictionary) {
+            if (const auto it = _references.find(value);
+                it != _references.end()) {
+                _head(majorTag, tagStringReference);
+                _head(majorUnsigned, it->second);
+                return;
+            }
+            // the decoder numbers every long enough string the same way
+            if (value.size() >= min_reference_length(_references.size()))
+                _references.emplace(value, _references.size());
+        }
+        _head(majorText, value.size());
+        _out += value;
+    }
+
+    auto _double(double value) -> void {
+        if (const auto single = static_cast<float>(value); single == value) {
+            _out += static_cast<char>(majorSimple << 5 | 26);
+            _big_endian(std::bit_cast<std::uint32_t>(single), 4);
+        } else {
+            _out += static_cast<char>(majorSimple << 5 | 27);
+            _big_endian(std::bit_cast<std::uint64_t>(value), 8);
+        }
+    }
+
+    auto _bignum(bool negative, std::string_view digits) -> void {
+        const auto bytes{decimal_to_bytes(
+            negative ? decrement(std::string{digits}) : std::string{digits})};
+        _head(majorTag, negative ? tagNegativeBignum : tagPositiveBignum);
+        _head(majorBytes, bytes.size());
+        _out += bytes;
+    }
+
+    // the lexeme is split into a digit string and a power of ten
+    auto _raw(std::string_view lexeme) -> void {
+        const auto source{lexeme};
+        const bool negative{lexeme.starts_with('-')};
+        if (negative) lexeme.remove_prefix(1);
+
+        // exponents past 64 bits have no decimal fraction encoding, and the
+        // lowest one has no negation the decoder could read back
+        const auto outOfRange{[&] {
+            throw invalid_cbor_exception(std::format(
+                "exponent of raw number `{}` out of range", source));
+        }};
+
+        std::int64_t exponent{0};
+        if (const auto end = lexeme.find_first_of("eE");
+            end != std::string_view::npos) {
+            auto power{lexeme.substr(end + 1)};
+            if (power.starts_with('+')) power.remove_prefix(1);
+            const auto last{power.data() + power.size()};
+            if (const auto res = std::from_chars(power.data(), last, exponent);
+                res.ec != std::errc{} || res.ptr != last)
+                outOfRange();
+            lexeme = lexeme.substr(0, end);
+        }
+
+        std::string digits{};
+        bool fraction{false};
+        for (const auto ch : lexeme) {
+            if (ch == '.') {
+                fraction = true;
+                continue;
+            }
+            if (ch != '0' || !digits.empty()) digits += ch;
+            if (!fraction) continue;
+            if (exponent == std::numeric_limits<std::int64_t>::min())
+                outOfRange();
+            exponent--;
+        }
+        if (exponent == std::numeric_limits<std::int64_t>::min())
+            outOfRange();
+        if (digits.empty()) digits = "0";
+
+        if (exponent != 0) {
+            _head(majorTag, tagDecimalFraction);
+            _head(majorArray, 2);
+            if (exponent < 0)
+                _head(majorNegative,
+                      static_cast<std::uint64_t>(-(exponent + 1)));
+            else
+                _head(majorUnsigned, static_cast<std::uint64_t>(exponent));
+        }
+        _bignum(negative, digits);
+    }
+
+    auto _value(const node& value) -> void {
+        switch (value.tag()) {
+            case node_tag::JsonNull:
+                _out += static_cast<char>(majorSimple << 5 | 22);
+                break;
+
+            case node_tag::JsonBool:
+                _out += static_cast<char>(majorSimple << 5 |
+                                          (value.value<bool>() ? 21 : 20));
+                break;
+
+            case node_tag::JsonInt:
+            case node_tag::JsonFloat:
+                if (const auto raw = value.get_if<raw_number>())
+                    _raw(raw->lexeme);
+                else if (const auto real = value.get_if<double>())
+                    _double(*real);
+                else if (const auto integer = value.get_if<std::int64_t>();
+                         integer && *integer < 0)
+                    _head(majorNegative,
+                          static_cast<std::uint64_t>(-(*integer + 1)));
+                else
+                    _head(majorUnsigned, value.value<std::uint64_t>());
+                break;
+
+            case node_tag::JsonString:
+                _string(value.string());
+                break;
+
+            case node_tag::JsonArray:
+                _head(majorArray, value.items().size());
+                for (const auto& item : value.items()) _value(item);
+                break;
+
+            case node_tag::JsonObject:
+                _head(majorMap, value.fields().size());
+                for (const auto& [key, field] : value.fields()) {
+                    _string(key.view());
+                    _value(field);
+                }
+                break;
+        }
+    }
+
+   private:
+    std::string& _out;
+    const cbor_options& _options;
+    // views into the tree being encoded
+    std::unordered_map<std::string_view, std::size_t> _references{};
+};
+
+/* decoder */
+class cbor_decoder final {
+   public:
+    cbor_decoder(std::string_view content, const parse_options& options)
+        : _content(content),
+          _options(options),
+          _resource(resource_of(options)) {}
+
+    auto decode() -> node {
+        auto retval{_value(_byte())};
+        if (_idx != _content.size())
+            throw invalid_cbor_exception(std::format(
+                "unexpected bytes after the root item at offset {}", _idx));
+        return retval;
+    }
+
+   private:
+    // a string of the input, or one assembled from indefinite chunks
+    struct text {
+        std::string_view value;
+        bool borrowed;
+    };
+
+    [[noreturn]] auto _throw(std::string_view what) const -> void {
+        throw invalid_cbor_exception(
+            std::format("{} at offset {}", what, _idx));
+    }
+
+    auto _byte() -> std::uint8_t {
+        if (_idx >= _content.size()) _throw("unexpected end of input");
+        return static_cast<std::uint8_t>(_content[_idx++]);
+    }
+
+    auto _big_endian(uint bytes) -> std::uint64_t {
+        if (_content.size() - _idx < bytes) _throw("unexpected end of input");
+        std::uint64_t retval{0};
+        for (uint i{0}; i < bytes; i++)
+            retval = retval << 8 | static_cast<std::uint8_t>(_content[_idx++]);
+        return retval;
+    }
+
+    auto _argument(std::uint8_t head) -> std::uint64_t {
+        switch (const auto info = head & 0x1F) {
+            case 24:
+                return _big_endian(1);
+            case 25:
+                return _big_endian(2);
+            case 26:
+                return _big_endian(4);
+            case 27:
+                return _big_endian(8);
+            default:
+                if (info > 27) _throw("unexpected additional information");
+                return info;
+        }
+    }
+
+    // untrusted lengths: every item takes at least one byte
+    auto _length(std::uint8_t head) -> std::size_t {
+        const auto length{_argument(head)};
+        if (length > _content.size() - _idx) _throw("length past the input");
+        return length;
+    }
+
+    auto _bytes(std::size_t length) -> std::string_view {
+        const auto retval{_content.substr(_idx, length)};
+        _idx += length;
+        return retval;
+    }
+
+    // malformed utf-8 is reported like every other cbor error
+    static auto _validate(std::string_view value, std::size_t position)
+        -> void {
+        try {
+            validate_utf8(value, position);
+        } catch (const std::exception& ex) {
+            throw invalid_cbor_exception(ex.what());
+        }
+    }
+
+    auto _text(std::uint8_t head) -> text {
+        const auto position{_idx};
+        if ((head & 0x1F) != indefinite) {
+            const auto value{_bytes(_length(head))};
+            _validate(value, position);
+            if (!_namespaces.empty() &&
+                value.size() >= min_reference_length(_namespaces.back().size()))
+                _namespaces.back().push_back(value);
+            return {value, true};
+        }
+
+        _chunks.clear();
+        for (auto chunk{_byte()}; chunk != breakCode; chunk = _byte()) {
+            if (chunk >> 5 != majorText || (chunk & 0x1F) == indefinite)
+                _throw("malformed indefinite length string");
+            _chunks += _bytes(_length(chunk));
+        }
+        _validate(_chunks, position);
+        return {_chunks, false};
+    }
+
+    auto _reference() -> text {
+        const auto head{_byte()};
+        const auto index{_argument(head)};
+        if (head >> 5 != majorUnsigned || _namespaces.empty() ||
+            index >= _namespaces.back().size())
+            _throw("invalid string reference");
+        return {_namespaces.back()[index], true};
+    }
+
+    auto _key() -> object_key {
+        auto head{_byte()};
+        text key{};
+        if (head >> 5 == majorText) {
+            key = _text(head);
+        } else if (head >> 5 == majorTag &&
+                   _argument(head) == tagStringReference) {
+            key = _reference();
+        } else {
+            _throw("map keys must be text strings");
+        }
+
+        if (_options.symbols)
+            return object_key{_options.symbols->intern(key.value), _resource};
+        return object_key{key.value, _resource};
+    }
+
+    auto _string_node(text value) -> node {
+        if (_options.borrow_strings && value.borrowed) return node{value.value};
+        if (_options.resource)
+            return node{copy_string(value.value, _resource)};
+        return node{std::string{value.value}};
+    }
+
+    auto _array(std::uint8_t head) -> node {
+        array retval(_resource);
+        if ((head & 0x1F) == indefinite) {
+            for (auto item{_byte()}; item != breakCode; item = _byte())
+                retval.push_back(_value(item));
+        } else {
+            const auto size{_length(head)};
+            retval.reserve(size);
+            for (std::size_t i{0}; i < size; i++)
+                retval.push_back(_value(_byte()));
+        }
+        return node{std::move(retval)};
+    }
+
+    auto _map(std::uint8_t head) -> node {
+        object retval(_resource);
+        const auto insert{[&] {
+            const auto position{_idx};
+            auto key{_key()};
+            if (!retval.emplace(std::move(key), _value(_byte())).second)
+                throw invalid_cbor_exception(std::format(
+                    "duplicate key found in map at offset {}", position));
+        }};
+
+        if ((head & 0x1F) == indefinite) {
+            while (_idx < _content.size() &&
+                   static_cast<std::uint8_t>(_content[_idx]) != breakCode)
+                insert();
+            _byte();
+        } else {
+            const auto size{_length(head)};
+            retval.reserve(size);
+            for (std::size_t i{0}; i < size; i++) insert();
+        }
+        return node{std::move(retval)};
+    }
+
+    // digits of an integer or a bignum, for decimal fractions
+    auto _magnitude(bool& negative) -> std::string {
+        const auto head{_byte()};
+        switch (head >> 5) {
+            case majorUnsigned:
+            case majorNegative: {
+                negative = head >> 5 == majorNegative;
+                char buf[32];
+                const auto res{
+                    std::to_chars(buf, buf + sizeof(buf), _argument(head))};
+                const std::string digits{buf, res.ptr};
+                return negative ? increment(digits) : digits;
+            }
+
+            case majorTag:
+                if (const auto tag = _argument(head);
+                    tag == tagPositiveBignum || tag == tagNegativeBignum) {
+                    negative = tag == tagNegativeBignum;
+                    return _bignum_digits(negative);
+                }
+                [[fallthrough]];
+
+            default:
+                _throw("expected an integer");
+        }
+    }
+
+    auto _bignum_digits(bool negative) -> std::string {
+        const auto head{_byte()};
+        if (head >> 5 != majorBytes || (head & 0x1F) == indefinite)
+            _throw("expected the bytes of a bignum");
+        const auto digits{bytes_to_decimal(_bytes(_length(head)))};
+        return negative ? increment(digits) : digits;
+    }
+
+    // integers that fit 64 bits keep their exact value, like in the lexer
+    auto _number_node(bool negative, const std::string& digits,
+                      std::int64_t exponent) -> node {
+        auto lexeme{negative ? '-' + digits : digits};
+        if (exponent != 0) lexeme += std::format("e{}", exponent);
+
+        const auto first{lexeme.data()};
+        const auto last{lexeme.data() + lexeme.size()};
+        if (exponent == 0) {
+            if (std::int64_t value{};
+                std::from_chars(first, last, value).ec == std::errc{})
+                return node{value};
+            if (std::uint64_t value{};
+                std::from_chars(first, last, value).ec == std::errc{})
+                return node{value};
+        }
+        if (_options.raw_numbers) return node{raw_number{std::move(lexeme)}};
+
+        double value{};
+        if (std::from_chars(first, last, value).ec != std::errc{})
+            _throw("number out of range");
+        return node{value};
+    }
+
+    auto _tagged(std::uint64_t tag) -> node {
+        switch (tag) {
+            case tagPositiveBignum:
+            case tagNegativeBignum: {
+                const bool negative{tag == tagNegativeBignum};
+                return _number_node(negative, _bignum_digits(negative), 0);
+            }
+
+            case tagDecimalFraction: {
+                if (_byte() != (majorArray << 5 | 2))
+                    _throw("expected a decimal fraction pair");
+                bool negative{false};
+                const auto exponentDigits{_magnitude(negative)};
+                std::int64_t exponent{};
+                if (std::from_chars(exponentDigits.data(),
+                                    exponentDigits.data() +
+                                        exponentDigits.size(),
+                                    exponent)
+                        .ec != std::errc{})
+                    _throw("decimal fraction exponent out of range");
+                if (negative) exponent = -exponent;
+
+                const auto digits{_magnitude(negative)};
+                return _number_node(negative, digits, exponent);
+            }
+
+            case tagStringReference:
+                return _string_node(_reference());
+
+            case tagStringNamespace: {
+                _namespaces.emplace_back();
+                auto retval{_value(_byte())};
+                _namespaces.pop_back();
+                return retval;
+            }
+
+            // other tags only add semantics to the item they enclose
+            default:
+                return _value(_byte());
+        }
+    }
+
+    auto _simple(std::uint8_t head) -> node {
+        switch (head & 0x1F) {
+            case 20:
+                return node{false};
+            case 21:
+                return node{true};
+            case 22:
+            case 23:
+                return node{};
+            case 25:
+                return node{_half(static_cast<std::uint16_t>(_big_endian(2)))};
+            case 26:
+                return node{static_cast<double>(std::bit_cast<float>(
+                    static_cast<std::uint32_t>(_big_endian(4))))};
+            case 27:
+                return node{std::bit_cast<double>(_big_endian(8))};
+            default:
+                _throw("unsupported simple value");
+        }
+    }
+
+    static auto _half(std::uint16_t bits) noexcept -> double {
+        const auto exponent{bits >> 10 & 0x1F};
+        const auto mantissa{static_cast<double>(bits & 0x3FF)};
+        const auto value{
+            exponent == 0    ? std::ldexp(mantissa, -24)
+            : exponent != 31 ? std::ldexp(mantissa + 1024, exponent - 25)
+            : mantissa == 0  ? std::numeric_limits<double>::infinity()
+                             : std::numeric_limits<double>::quiet_NaN()};
+        return bits & 0x8000 ? -value : value;
+    }
+
+    auto _value(std::uint8_t head) -> node {
+        switch (head >> 5) {
+            case majorUnsigned:
+                if (const auto value = _argument(head);
+                    value <= std::numeric_limits<std::int64_t>::max())
+                    return node{static_cast<std::int64_t>(value)};
+                else
+                    return node{value};
+
+            case majorNegative:
+                if (const auto value = _argument(head);
+                    value <= std::numeric_limits<std::int64_t>::max())
+                    return node{-1 - static_cast<std::int64_t>(value)};
+                else
+                    return _number_node(true, increment(std::to_string(value)),
+                                        0);
+
+            case majorBytes:
+                _throw("byte strings have no json counterpart");
+
+            case majorText:
+                return _string_node(_text(head));
+
+            case majorArray:
+                return _array(head);
+
+            case majorMap:
+                return _map(head);
+
+            case majorTag:
+                return _tagged(_argument(head));
+
+            default:
+                return _simple(head);
+        }
+    }
+
+   private:
+    std::string_view _content;
+    std::size_t _idx{0};
+    const parse_options& _options;
+    std::pmr::memory_resource* _resource;
+    // string references of the enclosing namespaces, innermost last
+    std::vector<std::vector<std::string_view>> _namespaces{};
+    std::string _chunks{};
+};
+
+auto serialize_cbor(const node& root, const cbor_options& options)
+    -> std::string {
+    std::string retval{};
+    serialize_cbor(root, retval, options);
+    return retval;
+}
+
+auto serialize_cbor(const node& root, std::string& buffer,
+                    const cbor_options& options) -> void {
+    cbor_encoder{buffer, options}.encode(root);
+}
+
+auto deserialize_cbor(std::string_view content, const parse_options& options)
+    -> node {
+    return cbor_decoder{content, options}.decode();
+}
+}  // namespace json
@@ -0,0 +1,45 @@
+#pragma once
+#include <exception>
+#include <string>
+#include <string_view>
+
+#include "json.hpp"
+#include "parser.hpp"
+
+namespace json {
+class invalid_cbor_exception final : public std::exception {
+   public:
+    invalid_cbor_exception(const std::string& msg) : _msg(msg) {}
+    auto what() const noexcept -> const char* {
+        return _msg.c_str();
+    }
+
+   private:
+    const std::string _msg{};
+};
+
+struct cbor_options {
+    // repeated strings are written once and then referenced by index, using
+    // the stringref tags 256 and 25 registered with IANA
+    bool key_dictionary{false};
+};
+
+// cbor (rfc 8949) with definite lengths and the shortest encoding of every
+// head; doubles are written as single precision floats when that is exact,
+// raw numbers as bignums (tags 2 and 3) or decimal fractions (tag 4)
+[[nodiscard]]
+auto serialize_cbor(const node& root, const cbor_options& options = {})
+    -> std::string;
+// appends to `buffer`, which can be cleared and reused between calls
+auto serialize_cbor(const node& root, std::string& buffer,
+                    const cbor_options& options = {}) -> void;
+
+// containers are sized from their heads before any item is decoded;
+// indefinite lengths, half precision floats and string references from
+// other encoders are accepted, byte strings and non-string keys are not;
+// bignums and decimal fractions that do not fit 64 bits become raw numbers
+// with `raw_numbers`, doubles otherwise
+[[nodiscard]]
+auto deserialize_cbor(std::string_view content,
+                      const parse_options& options = {}) -> node;
+}  // namespace json
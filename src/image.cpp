@@ -0,0 +1,484 @@
+#include "image.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace json {
+// "JSONIMG" and the format version, in the byte order of the machine
+constexpr std::uint64_t imageMagic{0x01474D494E4F534A};
+// magic, total size and root word
+constexpr std::uint64_t headerSize{24};
+constexpr std::uint64_t payloadMask{(std::uint64_t{1} << 56) - 1};
+// integers stored inside their word
+constexpr std::int64_t inlineMin{-(std::int64_t{1} << 55)};
+constexpr std::int64_t inlineMax{(std::int64_t{1} << 55) - 1};
+
+// raw numbers are tagged like `node(raw_number)` does
+auto is_integer_lexeme(std::string_view lexeme) noexcept -> bool {
+    return lexeme.find_first_of(".eE") == std::string_view::npos;
+}
+
+template <class Tp>
+auto parse_lexeme(std::string_view lexeme) -> Tp {
+    Tp retval{};
+    if (const auto [ptr, ec] = std::from_chars(
+            lexeme.data(), lexeme.data() + lexeme.size(), retval);
+        ec != std::errc{} || ptr != lexeme.data() + lexeme.size())
+        throw node_exception(
+            std::format("cannot read value: number `{}` out of range", lexeme));
+    return retval;
+}
+
+/* image_cursor implementation */
+image_cursor::image_cursor(std::string_view content,
+                           std::uint64_t word) noexcept
+    : _content(content), _word(word) {}
+
+auto image_cursor::tag() const -> node_tag {
+    switch (_type()) {
+        case 't':
+        case 'f':
+            return node_tag::JsonBool;
+        case 'i':
+        case 'l':
+        case 'u':
+            return node_tag::JsonInt;
+        case 'd':
+            return node_tag::JsonFloat;
+        case 'r':
+            return is_integer_lexeme(_read_string(_offset()))
+                       ? node_tag::JsonInt
+                       : node_tag::JsonFloat;
+        case '"':
+            return node_tag::JsonString;
+        case '[':
+            return node_tag::JsonArray;
+        case '{':
+            return node_tag::JsonObject;
+        default:
+            return node_tag::JsonNull;
+    }
+}
+
+auto image_cursor::size() const -> std::size_t {
+    if (const auto type = _type(); type != '[' && type != '{')
+        throw node_exception("cannot get the size of non-container nodes");
+    return _count();
+}
+
+auto image_cursor::at(uint idx) const -> image_cursor {
+    if (_type() != '[')
+        throw node_exception("cannot access non-array nodes items");
+
+    if (const auto count = _count(); idx >= count)
+        throw std::out_of_range(std::format(
+            "index out of range: node field size {} ({} was given)", count,
+            idx));
+
+    return {_content, _read(_offset() + 8 + 8 * std::uint64_t{idx})};
+}
+
+auto image_cursor::field(std::string_view key) const -> image_cursor {
+    if (_type() != '{')
+        throw node_exception("cannot access non-object nodes fields");
+
+    const auto entry{_find(key)};
+    if (entry == _count())
+        throw std::out_of_range(std::format("key `{}` not in dictionary", key));
+
+    return {_content, _read(_offset() + 16 + 16 * entry)};
+}
+
+auto image_cursor::contains(std::string_view key) const -> bool {
+    if (_type() != '{')
+        throw node_exception("cannot access non-object nodes fields");
+    return _find(key) != _count();
+}
+
+auto image_cursor::to_node() const -> node {
+    switch (_type()) {
+        case 't':
+        case 'f':
+            return node{_as_bool()};
+        case 'i':
+        case 'l':
+            return node{_as_int()};
+        case 'u':
+            return node{_as_uint()};
+        case 'd':
+            return node{_as_float()};
+        case 'r':
+            return node{raw_number{std::string{_read_string(_offset())}}};
+        case '"':
+            return node{std::string{_as_string()}};
+
+        case '[': {
+            array retval{};
+            retval.reserve(_count());
+            for (std::size_t i{0}; i < _count(); i++) {
+                const auto item{_child(_read(_offset() + 8 + 8 * i))};
+                retval.push_back(item.to_node());
+            }
+            return node{std::move(retval)};
+        }
+
+        case '{': {
+            object retval{};
+            retval.reserve(_count());
+            // entries are stored in document order
+            for (std::size_t i{0}; i < _count(); i++) {
+                const auto field{_child(_read(_offset() + 16 + 16 * i))};
+                retval.emplace(_key(i), field.to_node());
+            }
+            return node{std::move(retval)};
+        }
+
+        default:
+            _expect('n');
+            return node{};
+    }
+}
+
+// containers are written after their parent, so a crafted image cannot
+// make the recursion of `to_node` loop back to an ancestor
+auto image_cursor::_child(std::uint64_t word) const -> image_cursor {
+    const image_cursor retval{_content, word};
+    if (const auto type = retval._type();
+        (type == '[' || type == '{') && retval._offset() <= _offset())
+        throw invalid_image_exception(std::format(
+            "container at offset {} is not past its parent at offset {}",
+            retval._offset(), _offset()));
+    return retval;
+}
+
+auto image_cursor::_type() const noexcept -> char {
+    return static_cast<char>(_word >> 56);
+}
+
+auto image_cursor::_offset() const noexcept -> std::uint64_t {
+    return _word & payloadMask;
+}
+
+auto image_cursor::_bytes(std::uint64_t offset, std::uint64_t length) const
+    -> const char* {
+    if (offset > _content.size() || length > _content.size() - offset)
+        throw invalid_image_exception(std::format(
+            "offset {} is past the end of the image ({} bytes)", offset,
+            _content.size()));
+    return _content.data() + offset;
+}
+
+auto image_cursor::_read(std::uint64_t offset) const -> std::uint64_t {
+    std::uint64_t retval{};
+    std::memcpy(&retval, _bytes(offset, sizeof(retval)), sizeof(retval));
+    return retval;
+}
+
+auto image_cursor::_read_string(std::uint64_t offset) const
+    -> std::string_view {
+    std::uint32_t length{};
+    std::memcpy(&length, _bytes(offset, sizeof(length)), sizeof(length));
+    return {_bytes(offset + sizeof(length), length), length};
+}
+
+// checked against the bytes left, so a crafted count cannot size an
+// allocation or overflow the offsets of the entries
+auto image_cursor::_count() const -> std::size_t {
+    const auto count{_read(_offset())};
+    // objects also index their keys after the entries
+    const auto width{_type() == '{' ? 20 : 8};
+    if (count > (_content.size() - _offset() - 8) / width)
+        throw invalid_image_exception(std::format(
+            "container of {} entries at offset {} is past the end of the "
+            "image ({} bytes)",
+            count, _offset(), _content.size()));
+    return count;
+}
+
+auto image_cursor::_key(std::size_t entry) const -> std::string_view {
+    return _read_string(_read(_offset() + 8 + 16 * entry));
+}
+
+// the sorted index follows the entries, `count` when the key is missing
+auto image_cursor::_find(std::string_view key) const -> std::size_t {
+    const auto count{_count()};
+    const auto index{_offset() + 8 + 16 * count};
+
+    std::size_t low{0};
+    std::size_t high{count};
+    while (low < high) {
+        const auto middle{low + (high - low) / 2};
+        std::uint32_t entry{};
+        std::memcpy(&entry, _bytes(index + 4 * middle, sizeof(entry)),
+                    sizeof(entry));
+
+        if (const auto order = _key(entry).compare(key); order == 0)
+            return entry;
+        else if (order < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return count;
+}
+
+auto image_cursor::_expect(char type) const -> void {
+    if (_type() != type)
+        throw node_exception(
+            "cannot read value: image entry holds another type");
+}
+
+auto image_cursor::_as_bool() const -> bool {
+    if (_type() == 'f') return false;
+    _expect('t');
+    return true;
+}
+
+// conversions are range checked like `node::value`
+auto image_cursor::_as_int() const -> std::int64_t {
+    switch (_type()) {
+        case 'i':
+            return static_cast<std::int64_t>(_word << 8) >> 8;
+        case 'u':
+            if (const auto value = _as_uint();
+                value <= std::numeric_limits<std::int64_t>::max())
+                return static_cast<std::int64_t>(value);
+            throw node_exception("cannot read value: number out of range");
+        case 'r':
+            return parse_lexeme<std::int64_t>(_read_string(_offset()));
+        default:
+            _expect('l');
+            return std::bit_cast<std::int64_t>(_read(_offset()));
+    }
+}
+
+auto image_cursor::_as_uint() const -> std::uint64_t {
+    switch (_type()) {
+        case 'i':
+        case 'l':
+            if (const auto value = _as_int(); value >= 0)
+                return static_cast<std::uint64_t>(value);
+            throw node_exception("cannot read value: number out of range");
+        case 'r':
+            return parse_lexeme<std::uint64_t>(_read_string(_offset()));
+        default:
+            _expect('u');
+            return _read(_offset());
+    }
+}
+
+auto image_cursor::_as_small_int() const -> int {
+    if (const auto value = _as_int(); std::in_range<int>(value))
+        return static_cast<int>(value);
+    throw node_exception("cannot read value: number out of range");
+}
+
+auto image_cursor::_as_float() const -> double {
+    // integers are read as doubles too, like in `node::value`
+    switch (_type()) {
+        case 'i':
+        case 'l':
+            return static_cast<double>(_as_int());
+        case 'u':
+            return static_cast<double>(_as_uint());
+        case 'r':
+            return parse_lexeme<double>(_read_string(_offset()));
+        default:
+            _expect('d');
+            return std::bit_cast<double>(_read(_offset()));
+    }
+}
+
+auto image_cursor::_as_string() const -> std::string_view {
+    _expect('"');
+    return _read_string(_offset());
+}
+
+/* image implementation */
+image::image(const char* filepath)
+    : _file(filepath, map_access::Random), _content(_file.view()) {
+    _check();
+}
+
+image::image(std::string_view content) : _content(content) {
+    _check();
+}
+
+auto image::root() const -> image_cursor {
+    if (_content.empty()) throw node_exception("cannot access an empty image");
+
+    std::uint64_t word{};
+    std::memcpy(&word, _content.data() + 16, sizeof(word));
+    return {_content, word};
+}
+
+auto image::view() const noexcept -> std::string_view {
+    return _content;
+}
+
+// only the header is read, the values are checked as they are accessed
+auto image::_check() const -> void {
+    std::uint64_t magic{};
+    std::uint64_t size{};
+    if (_content.size() >= headerSize) {
+        std::memcpy(&magic, _content.data(), sizeof(magic));
+        std::memcpy(&size, _content.data() + 8, sizeof(size));
+    }
+
+    if (magic != imageMagic)
+        throw invalid_image_exception(
+            "not an image, or one of another version or byte order");
+    if (size != _content.size())
+        throw invalid_image_exception(std::format(
+            "truncated image: {} bytes out of {}", _content.size(), size));
+}
+
+/* image writer */
+class image_writer final {
+   public:
+    explicit image_writer(std::string& out) noexcept
+        : _out(out), _base(out.size()) {}
+
+    auto write(const node& root) -> void {
+        const auto header{_allocate(headerSize)};
+        _put(header, imageMagic);
+        const auto word{_value(root)};
+        _put(header + 16, word);
+        _put(header + 8, _out.size() - _base);
+    }
+
+   private:
+    static auto _word(char type, std::uint64_t payload) noexcept
+        -> std::uint64_t {
+        return static_cast<std::uint64_t>(type) << 56 | payload;
+    }
+
+    // blocks are 8 bytes aligned, relative to the start of the image
+    auto _allocate(std::uint64_t bytes) -> std::uint64_t {
+        _out.resize(_base + ((_out.size() - _base + 7) & ~std::uint64_t{7}));
+        const auto retval{_out.size() - _base};
+        _out.resize(_out.size() + bytes);
+        return retval;
+    }
+
+    template <class Tp>
+    auto _put(std::uint64_t offset, Tp value) noexcept -> void {
+        std::memcpy(_out.data() + _base + offset, &value, sizeof(value));
+    }
+
+    auto _number(std::uint64_t bits) -> std::uint64_t {
+        const auto offset{_allocate(8)};
+        _put(offset, bits);
+        return offset;
+    }
+
+    // equal strings and keys are stored once
+    auto _string(std::string_view value) -> std::uint64_t {
+        if (const auto it = _strings.find(value); it != _strings.end())
+            return it->second;
+
+        if (value.size() > std::numeric_limits<std::uint32_t>::max())
+            throw invalid_image_exception(std::format(
+                "string of {} bytes is too long for an image", value.size()));
+        const auto length{static_cast<std::uint32_t>(value.size())};
+        const auto offset{_allocate(sizeof(length) + value.size())};
+        _put(offset, length);
+        std::memcpy(_out.data() + _base + offset + sizeof(length), value.data(),
+                    value.size());
+        _strings.emplace(value, offset);
+        return offset;
+    }
+
+    auto _value(const node& value) -> std::uint64_t {
+        switch (value.tag()) {
+            case node_tag::JsonNull:
+                return _word('n', 0);
+
+            case node_tag::JsonBool:
+                return _word(value.value<bool>() ? 't' : 'f', 0);
+
+            case node_tag::JsonInt:
+            case node_tag::JsonFloat:
+                if (const auto raw = value.get_if<raw_number>())
+                    return _word('r', _string(raw->lexeme));
+                if (const auto real = value.get_if<double>())
+                    return _word('d',
+                                 _number(std::bit_cast<std::uint64_t>(*real)));
+                if (const auto integer = value.get_if<std::int64_t>()) {
+                    const auto bits{static_cast<std::uint64_t>(*integer)};
+                    if (*integer >= inlineMin && *integer <= inlineMax)
+                        return _word('i', bits & payloadMask);
+                    return _word('l', _number(bits));
+                }
+                return _word('u', _number(value.value<std::uint64_t>()));
+
+            case node_tag::JsonString:
+                return _word('"', _string(value.string()));
+
+            case node_tag::JsonArray: {
+                const auto& items{value.items()};
+                const auto offset{_allocate(8 + 8 * items.size())};
+                _put(offset, std::uint64_t{items.size()});
+                for (std::size_t i{0}; i < items.size(); i++) {
+                    const auto word{_value(items[i])};
+                    _put(offset + 8 + 8 * i, word);
+                }
+                return _word('[', offset);
+            }
+
+            case node_tag::JsonObject: {
+                const auto& fields{value.fields()};
+                const auto count{fields.size()};
+                const auto offset{_allocate(8 + 20 * count)};
+                _put(offset, std::uint64_t{count});
+
+                std::vector<std::string_view> keys{};
+                keys.reserve(count);
+                for (std::size_t i{0}; const auto& [key, field] : fields) {
+                    keys.push_back(key.view());
+                    const auto keyOffset{_string(key.view())};
+                    const auto word{_value(field)};
+                    _put(offset + 8 + 16 * i, keyOffset);
+                    _put(offset + 16 + 16 * i, word);
+                    i++;
+                }
+
+                std::vector<std::uint32_t> order(count);
+                std::iota(order.begin(), order.end(), 0);
+                std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+                    return keys[lhs] < keys[rhs];
+                });
+                for (std::size_t i{0}; i < count; i++)
+                    _put(offset + 8 + 16 * count + 4 * i, order[i]);
+                return _word('{', offset);
+            }
+        }
+        return _word('n', 0);
+    }
+
+   private:
+    std::string& _out;
+    std::size_t _base;
+    // views into the tree being written
+    std::unordered_map<std::string_view, std::uint64_t> _strings{};
+};
+
+auto serialize_image(const node& root) -> std::string {
+    std::string retval{};
+    serialize_image(root, retval);
+    return retval;
+}
+
+auto serialize_image(const node& root, std::string& buffer) -> void {
+    image_writer{buffer}.write(root);
+}
+}  // namespace json
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "json.hpp"
+#include "mapped_file.hpp"
+
+namespace json {
+class invalid_image_exception final : public std::exception {
+   public:
+    invalid_image_exception(const std::string& msg) : _msg(msg) {}
+    auto what() const noexcept -> const char* {
+        return _msg.c_str();
+    }
+
+   private:
+    const std::string _msg{};
+};
+
+// read-only view of a single value stored in an image; it only refers to
+// the bytes of the image, so it stays valid when the image is moved
+class image_cursor final {
+   public:
+    [[nodiscard]] auto tag() const -> node_tag;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    template <class Tp>
+    [[nodiscard]] auto value() const -> Tp {
+        if constexpr (std::is_same_v<void*, Tp>) {
+            _expect('n');
+            return nullptr;
+        } else if constexpr (std::is_same_v<bool, Tp>) {
+            return _as_bool();
+        } else if constexpr (std::is_same_v<std::int64_t, Tp>) {
+            return _as_int();
+        } else if constexpr (std::is_same_v<std::uint64_t, Tp>) {
+            return _as_uint();
+        } else if constexpr (std::is_same_v<int, Tp>) {
+            return _as_small_int();
+        } else if constexpr (std::is_floating_point_v<Tp>) {
+            return static_cast<Tp>(_as_float());
+        } else if constexpr (std::is_same_v<std::string_view, Tp>) {
+            return _as_string();
+        } else if constexpr (std::is_same_v<std::string, Tp>) {
+            return Tp{_as_string()};
+        } else {
+            static_assert(!sizeof(Tp), "unsupported image value type");
+        }
+    }
+
+    [[nodiscard]] auto at(uint idx) const -> image_cursor;
+    // binary search over the sorted keys of the object
+    [[nodiscard]] auto field(std::string_view key) const -> image_cursor;
+    [[nodiscard]] auto contains(std::string_view key) const -> bool;
+
+    // copies the value and everything below it into a tree
+    [[nodiscard]] auto to_node() const -> node;
+
+   private:
+    friend class image;
+    image_cursor(std::string_view content, std::uint64_t word) noexcept;
+
+    // cursor on a value below this container
+    [[nodiscard]] auto _child(std::uint64_t word) const -> image_cursor;
+    [[nodiscard]] auto _type() const noexcept -> char;
+    [[nodiscard]] auto _offset() const noexcept -> std::uint64_t;
+    // bounds checked, the image may come from anywhere
+    [[nodiscard]] auto _bytes(std::uint64_t offset, std::uint64_t length) const
+        -> const char*;
+    [[nodiscard]] auto _read(std::uint64_t offset) const -> std::uint64_t;
+    [[nodiscard]] auto _read_string(std::uint64_t offset) const
+        -> std::string_view;
+    [[nodiscard]] auto _count() const -> std::size_t;
+    [[nodiscard]] auto _key(std::size_t entry) const -> std::string_view;
+    [[nodiscard]] auto _find(std::string_view key) const -> std::size_t;
+
+    auto _expect(char type) const -> void;
+    auto _as_bool() const -> bool;
+    auto _as_int() const -> std::int64_t;
+    auto _as_uint() const -> std::uint64_t;
+    // range checked, like `node::value<int>`
+    auto _as_small_int() const -> int;
+    auto _as_float() const -> double;
+    auto _as_string() const -> std::string_view;
+
+   private:
+    std::string_view _content;
+    // type in the high byte, an inline integer or an offset below it
+    std::uint64_t _word;
+};
+
+// position independent document, compiled once by `serialize_image` and
+// queried in place: values are 64 bits words, containers and strings live
+// at offsets from the start of the image and object keys are indexed in
+// sorted order; opening only checks the header, so a mapped image is
+// ready in constant time and its pages are shared by every process
+// mapping the same file
+class image final {
+   public:
+    image() noexcept = default;
+    // maps the file for random access
+    explicit image(const char* filepath);
+    // borrows `content`, which must outlive the image and its cursors
+    explicit image(std::string_view content);
+
+    [[nodiscard]] auto root() const -> image_cursor;
+    [[nodiscard]] auto view() const noexcept -> std::string_view;
+
+   private:
+    auto _check() const -> void;
+
+   private:
+    mapped_file _file{};
+    std::string_view _content{};
+};
+
+// images are written in the byte order of the machine, the magic number
+// rejects them on a machine of the other order
+[[nodiscard]]
+auto serialize_image(const node& root) -> std::string;
+// appends to `buffer`, offsets are relative to the start of the image
+auto serialize_image(const node& root, std::string& buffer) -> void;
+}  // namespace json
@@ -1,11 +1,201 @@
 #include "json.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <charconv>
 #include <format>
+#include <functional>
 #include <stdexcept>
 #include <utility>
 
-/* json_node implementation */
+/* object implementation */
 namespace json {
+constexpr auto npos{static_cast<std::size_t>(-1)};
+constexpr std::uint64_t slotIndexMask{0xFFFFFFFF};
+
+object::object(std::pmr::memory_resource* resource) noexcept
+    : _entries(resource), _slots(resource) {}
+
+object::object(std::initializer_list<value_type> init,
+               std::pmr::memory_resource* resource)
+    : _entries(resource), _slots(resource) {
+    reserve(init.size());
+    for (const auto& [key, value] : init) emplace(key, node{value});
+}
+
+auto object::size() const noexcept -> std::size_t {
+    return _entries.size();
+}
+
+auto object::empty() const noexcept -> bool {
+    return _entries.empty();
+}
+
+auto object::capacity() const noexcept -> std::size_t {
+    return _entries.capacity();
+}
+
+auto object::index_capacity() const noexcept -> std::size_t {
+    return _slots.capacity();
+}
+
+auto object::reserve(std::size_t capacity) -> void {
+    _entries.reserve(capacity);
+    if (capacity > linear_scan_limit && _slots.size() < capacity * 2)
+        _rehash(capacity);
+}
+
+auto object::begin() noexcept -> iterator {
+    return _entries.begin();
+}
+
+auto object::end() noexcept -> iterator {
+    return _entries.end();
+}
+
+auto object::begin() const noexcept -> const_iterator {
+    return _entries.begin();
+}
+
+auto object::end() const noexcept -> const_iterator {
+    return _entries.end();
+}
+
+auto object::find(std::string_view key) noexcept -> iterator {
+    const auto idx{_lookup(key)};
+    return idx == npos ? end() : begin() + idx;
+}
+
+auto object::find(std::string_view key) const noexcept -> const_iterator {
+    const auto idx{_lookup(key)};
+    return idx == npos ? end() : begin() + idx;
+}
+
+auto object::find(symbol key) const noexcept -> const_iterator {
+    const auto idx{_lookup(key.hash, [&](const object_key& entry) {
+        return entry.interned() ? entry.view().data() == key.name.data()
+                                : entry == key.name;
+    })};
+    return idx == npos ? end() : begin() + idx;
+}
+
+auto object::contains(std::string_view key) const noexcept -> bool {
+    return _lookup(key) != npos;
+}
+
+auto object::at(std::string_view key) -> node& {
+    const auto idx{_lookup(key)};
+    if (idx == npos)
+        throw std::out_of_range(std::format("key `{}` not in dictionary", key));
+
+    return _entries[idx].second;
+}
+
+auto object::at(std::string_view key) const -> const node& {
+    const auto idx{_lookup(key)};
+    if (idx == npos)
+        throw std::out_of_range(std::format("key `{}` not in dictionary", key));
+
+    return _entries[idx].second;
+}
+
+auto object::operator[](std::string_view key) -> node& {
+    const auto idx{_lookup(key)};
+    if (idx != npos) return _entries[idx].second;
+
+    return _append(object_key{key, _entries.get_allocator()}, node{})
+        ->second;
+}
+
+auto object::emplace(object_key&& key, node&& value)
+    -> std::pair<iterator, bool> {
+    const auto idx{_lookup(key)};
+    if (idx != npos) return {begin() + idx, false};
+
+    return {_append(std::move(key), std::move(value)), true};
+}
+
+auto object::emplace(std::string_view key, node&& value)
+    -> std::pair<iterator, bool> {
+    const auto idx{_lookup(key)};
+    if (idx != npos) return {begin() + idx, false};
+
+    return {_append(object_key{key, _entries.get_allocator()},
+                    std::move(value)),
+            true};
+}
+
+auto object::erase(std::string_view key) -> bool {
+    const auto idx{_lookup(key)};
+    if (idx == npos) return false;
+
+    _entries.erase(begin() + idx);
+    if (_entries.size() > linear_scan_limit)
+        _rehash(_entries.size());
+    else
+        _slots.clear();
+    return true;
+}
+
+template <class Equal>
+auto object::_lookup(std::size_t hash, Equal&& equal) const noexcept
+    -> std::size_t {
+    if (_slots.empty()) {
+        for (std::size_t idx{0}; idx < _entries.size(); idx++)
+            if (equal(_entries[idx].first)) return idx;
+        return npos;
+    }
+
+    const auto mask{_slots.size() - 1};
+    for (auto pos{hash & mask};; pos = (pos + 1) & mask) {
+        const auto slot{_slots[pos]};
+        if (slot == 0) return npos;
+
+        const auto idx{(slot & slotIndexMask) - 1};
+        if ((slot >> 32) == (hash >> 32) && equal(_entries[idx].first))
+            return idx;
+    }
+}
+
+auto object::_lookup(std::string_view key) const noexcept -> std::size_t {
+    // small objects are scanned without hashing the key
+    const auto hash{_slots.empty() ? 0 : std::hash<std::string_view>{}(key)};
+    return _lookup(hash, [&](const object_key& entry) { return entry == key; });
+}
+
+auto object::_append(object_key&& key, node&& value) -> iterator {
+    _entries.emplace_back(std::move(key), std::move(value));
+    const auto count{_entries.size()};
+    // the table may exist early, sized by `reserve`
+    if (count <= linear_scan_limit && _slots.empty()) return end() - 1;
+
+    // keep the table at most half full
+    if (_slots.size() < count * 2) {
+        _rehash(count);
+        return end() - 1;
+    }
+
+    const auto hash{std::hash<std::string_view>{}(_entries.back().first.view())};
+    const auto mask{_slots.size() - 1};
+    auto pos{hash & mask};
+    while (_slots[pos] != 0) pos = (pos + 1) & mask;
+    _slots[pos] = (hash >> 32) << 32 | count;
+    return end() - 1;
+}
+
+auto object::_rehash(std::size_t capacity) -> void {
+    _slots.assign(std::bit_ceil(std::max<std::size_t>(capacity * 2, 16)), 0);
+
+    const auto mask{_slots.size() - 1};
+    for (std::size_t idx{0}; idx < _entries.size(); idx++) {
+        const auto hash{std::hash<std::string_view>{}(_entries[idx].first.view())};
+        auto pos{hash & mask};
+        while (_slots[pos] != 0) pos = (pos + 1) & mask;
+        _slots[pos] = (hash >> 32) << 32 | (idx + 1);
+    }
+}
+
+/* json_node implementation */
 auto node::operator=(const node& other) noexcept -> node& {
     _tag = other._tag;
     _value = other._value;
@@ -20,10 +210,56 @@ auto node::operator=(node&& other) noexcept -> node& {
 
 node::node() noexcept : _tag(node_tag::JsonNull), _value((void*)NULL) {}
 
+node::node(raw_number value) noexcept
+    : _tag(value.lexeme.find_first_of(".eE") == std::string::npos
+               ? node_tag::JsonInt
+               : node_tag::JsonFloat),
+      _value(std::move(value)) {}
+
 auto node::tag() const noexcept -> node_tag {
     return _tag;
 }
 
+auto node::items() -> array& {
+    if (_tag != node_tag::JsonArray)
+        throw node_exception("cannot access non-array nodes items");
+
+    return std::get<array>(_value);
+}
+
+auto node::items() const -> const array& {
+    if (_tag != node_tag::JsonArray)
+        throw node_exception("cannot access non-array nodes items");
+
+    return std::get<array>(_value);
+}
+
+auto node::span() const -> std::span<const node> {
+    return items();
+}
+
+auto node::fields() -> object& {
+    if (_tag != node_tag::JsonObject)
+        throw node_exception("cannot access non-object nodes fields");
+
+    return std::get<object>(_value);
+}
+
+auto node::fields() const -> const object& {
+    if (_tag != node_tag::JsonObject)
+        throw node_exception("cannot access non-object nodes fields");
+
+    return std::get<object>(_value);
+}
+
+auto node::string() const -> std::string_view {
+    if (_tag != node_tag::JsonString)
+        throw node_exception("cannot access non-string nodes value");
+
+    if (const auto view = std::get_if<std::string_view>(&_value)) return *view;
+    return std::get<std::string>(_value);
+}
+
 auto node::at(uint idx) -> node& {
     if (_tag != node_tag::JsonArray)
         throw node_exception("cannot access non-array nodes items");
@@ -50,25 +286,55 @@ auto node::at(uint idx) const -> const node& {
     return value[idx];
 }
 
-auto node::field(std::string key) -> node& {
+auto node::field(std::string_view key) -> node& {
     if (_tag != node_tag::JsonObject)
         throw node_exception("cannot access non-object nodes fields");
 
     auto& value{std::get<object>(_value)};
-    if (!value.contains(key))
+    const auto it{value.find(key)};
+    if (it == value.end())
         throw std::out_of_range(std::format("key `{}` not in dictionary", key));
 
-    return value.at(key);
+    return it->second;
 }
 
-auto node::field(std::string key) const -> const node& {
+auto node::field(symbol key) const -> const node& {
     if (_tag != node_tag::JsonObject)
         throw node_exception("cannot access non-object nodes fields");
 
     const auto& value{std::get<object>(_value)};
-    if (!value.contains(key))
+    const auto it{value.find(key)};
+    if (it == value.end())
+        throw std::out_of_range(
+            std::format("key `{}` not in dictionary", key.name));
+
+    return it->second;
+}
+
+auto node::field(std::string_view key) const -> const node& {
+    if (_tag != node_tag::JsonObject)
+        throw node_exception("cannot access non-object nodes fields");
+
+    const auto& value{std::get<object>(_value)};
+    const auto it{value.find(key)};
+    if (it == value.end())
         throw std::out_of_range(std::format("key `{}` not in dictionary", key));
 
-    return value.at(key);
+    return it->second;
+}
+
+auto node::_parse_double(std::string_view lexeme) -> double {
+    double value{};
+    const auto last{lexeme.data() + lexeme.size()};
+    if (const auto res = std::from_chars(lexeme.data(), last, value);
+        res.ec != std::errc{} || res.ptr != last)
+        throw node_exception(
+            std::format("raw number `{}` does not fit a double", lexeme));
+    return value;
+}
+
+auto node::_throw_number(const char* type) const -> void {
+    throw node_exception(std::format(
+        "cannot access node holding type index {} as {}", _value.index(), type));
 }
 }  // namespace json
@@ -1,12 +1,20 @@
 #pragma once
 
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <format>
-#include <map>
+#include <initializer_list>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -25,14 +33,150 @@ class node_exception final : public std::exception {
 class node;
 using node_ptr = std::shared_ptr<node>;
 
-using array = std::vector<node>;
-using object = std::map<std::string, node>;
+using array = std::pmr::vector<node>;
+
+// object key interned by a `symbol_table`, names of one table with equal
+// content share their address
+struct symbol {
+    std::string_view name{};
+    // std::hash of the name, so lookups do not hash it again
+    std::size_t hash{};
+};
+
+// object key owning its characters, or borrowing them from a symbol table
+class object_key final {
+   public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    object_key(std::string_view value, const allocator_type& allocator = {})
+        : _owned(value, allocator) {}
+    object_key(const char* value, const allocator_type& allocator = {})
+        : _owned(value, allocator) {}
+    explicit object_key(symbol value,
+                        const allocator_type& allocator = {}) noexcept
+        : _owned(allocator), _symbol(value.name) {}
+
+    object_key(const object_key& other, const allocator_type& allocator = {})
+        : _owned(other._owned, allocator), _symbol(other._symbol) {}
+    object_key(object_key&& other) noexcept = default;
+    object_key(object_key&& other, const allocator_type& allocator)
+        : _owned(std::move(other._owned), allocator),
+          _symbol(other._symbol) {}
+    auto operator=(const object_key& other) -> object_key& = default;
+    auto operator=(object_key&& other) noexcept -> object_key& = default;
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view {
+        return _symbol.data() ? _symbol : std::string_view{_owned};
+    }
+
+    [[nodiscard]] auto interned() const noexcept -> bool {
+        return _symbol.data() != nullptr;
+    }
+
+    operator std::string_view() const noexcept {
+        return view();
+    }
+
+    friend auto operator==(const object_key& lhs, std::string_view rhs) noexcept
+        -> bool {
+        return lhs.view() == rhs;
+    }
+
+   private:
+    std::pmr::string _owned;
+    std::string_view _symbol{};
+};
+
+// insertion ordered fields, small objects are scanned linearly while larger
+// ones are indexed by an open addressing hash table over string_view keys
+class object final {
+   public:
+    using value_type = std::pair<object_key, node>;
+    using iterator = std::pmr::vector<value_type>::iterator;
+    using const_iterator = std::pmr::vector<value_type>::const_iterator;
+
+    static constexpr std::size_t linear_scan_limit{8};
+
+    object() noexcept = default;
+    explicit object(std::pmr::memory_resource* resource) noexcept;
+    object(std::initializer_list<value_type> init,
+           std::pmr::memory_resource* resource =
+               std::pmr::get_default_resource());
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+    [[nodiscard]] auto empty() const noexcept -> bool;
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+    // slots of the key index, 0 while the object is small enough to scan
+    [[nodiscard]] auto index_capacity() const noexcept -> std::size_t;
+    auto reserve(std::size_t capacity) -> void;
+
+    [[nodiscard]] auto begin() noexcept -> iterator;
+    [[nodiscard]] auto end() noexcept -> iterator;
+    [[nodiscard]] auto begin() const noexcept -> const_iterator;
+    [[nodiscard]] auto end() const noexcept -> const_iterator;
+
+    [[nodiscard]] auto find(std::string_view key) noexcept -> iterator;
+    [[nodiscard]] auto find(std::string_view key) const noexcept
+        -> const_iterator;
+    // keys interned by the same table are compared by address
+    [[nodiscard]] auto find(symbol key) const noexcept -> const_iterator;
+    [[nodiscard]] auto contains(std::string_view key) const noexcept -> bool;
+    auto at(std::string_view key) -> node&;
+    auto at(std::string_view key) const -> const node&;
+    auto operator[](std::string_view key) -> node&;
+
+    // existing keys are left untouched, the iterator points to their entry
+    auto emplace(object_key&& key, node&& value)
+        -> std::pair<iterator, bool>;
+    auto emplace(std::string_view key, node&& value)
+        -> std::pair<iterator, bool>;
+    auto emplace(const char* key, node&& value) -> std::pair<iterator, bool> {
+        return emplace(std::string_view{key}, std::move(value));
+    }
+    auto erase(std::string_view key) -> bool;
+
+   private:
+    template <class Equal>
+    [[nodiscard]] auto _lookup(std::size_t hash, Equal&& equal) const noexcept
+        -> std::size_t;
+    [[nodiscard]] auto _lookup(std::string_view key) const noexcept
+        -> std::size_t;
+    auto _append(object_key&& key, node&& value) -> iterator;
+    auto _rehash(std::size_t capacity) -> void;
+
+   private:
+    std::pmr::vector<value_type> _entries{};
+    // hash in the upper half, entry index + 1 in the lower one, 0 when empty
+    std::pmr::vector<std::uint64_t> _slots{};
+};
+
+// lexeme of a number kept verbatim, see `parse_options::raw_numbers`
+struct raw_number {
+    std::string lexeme{};
+};
 
 using value_t =
-    std::variant<void*, bool, int, float, std::string, array, object>;
+    std::variant<void*, bool, std::int64_t, std::uint64_t, double, std::string,
+                 std::string_view, array, object, raw_number>;
+
+// arithmetic values are stored as int64, uint64 or double
+template <class Tp>
+concept is_node_number = std::is_arithmetic_v<Tp> && !std::is_same_v<bool, Tp>;
 
 template <class Tp>
-concept is_node_convertible = std::is_constructible_v<value_t, Tp>;
+concept is_node_convertible =
+    is_node_number<Tp> || std::is_constructible_v<value_t, Tp>;
+
+template <class Tp, class Variant>
+struct is_alternative_of;
+
+template <class Tp, class... Types>
+struct is_alternative_of<Tp, std::variant<Types...>>
+    : std::bool_constant<(std::is_same_v<Tp, Types> || ...)> {};
+
+// types held as is, which can be accessed by reference
+template <class Tp>
+concept is_node_value = is_alternative_of<Tp, value_t>::value;
 
 enum class node_tag : uint {
     JsonNull,
@@ -47,60 +191,178 @@ enum class node_tag : uint {
 class node final {
    public:
     node() noexcept;
-    template <is_node_convertible Tp>
-    node(Tp value) {
-        _set_value(value);
-    }
+    template <class Tp>
+        requires is_node_convertible<std::remove_cvref_t<Tp>> &&
+                 (!std::is_same_v<raw_number, std::remove_cvref_t<Tp>>)
+    node(Tp&& value)
+        : _tag(_tag_of<std::remove_cvref_t<Tp>>()),
+          _value(_stored(std::forward<Tp>(value))) {}
+    // tagged as an int or a float depending on the lexeme
+    node(raw_number value) noexcept;
 
     node(const node& other) noexcept : _tag(other._tag), _value(other._value) {}
+    node(node&& other) noexcept
+        : _tag(other._tag), _value(std::move(other._value)) {}
     auto operator=(const node& other) noexcept -> node&;
     auto operator=(node&& other) noexcept -> node&;
 
     [[nodiscard]] auto tag() const noexcept -> node_tag;
 
+    // numbers convert to any arithmetic type that holds them exactly, integers
+    // to floating point types too
+    template <is_node_convertible Tp>
+    [[nodiscard]] auto value() const& -> Tp {
+        if constexpr (is_node_number<Tp>) {
+            return _number<Tp>();
+        } else {
+            // string nodes may either own their value or borrow it
+            if constexpr (std::is_same_v<std::string, Tp>) {
+                if (const auto view = std::get_if<std::string_view>(&_value))
+                    return Tp{*view};
+            } else if constexpr (std::is_same_v<std::string_view, Tp>) {
+                if (const auto str = std::get_if<std::string>(&_value))
+                    return *str;
+            }
+
+            return std::get<Tp>(_value);
+        }
+    }
+
+    // moves the value out of an expiring node instead of copying it
     template <is_node_convertible Tp>
-    [[nodiscard]] auto value() const -> Tp {
-        return std::get<Tp>(_value);
+    [[nodiscard]] auto value() && -> Tp {
+        if constexpr (is_node_number<Tp>) {
+            return _number<Tp>();
+        } else {
+            if constexpr (std::is_same_v<std::string, Tp>) {
+                if (const auto view = std::get_if<std::string_view>(&_value))
+                    return Tp{*view};
+            } else if constexpr (std::is_same_v<std::string_view, Tp>) {
+                if (const auto str = std::get_if<std::string>(&_value))
+                    return *str;
+            }
+
+            return std::get<Tp>(std::move(_value));
+        }
+    }
+
+    template <is_node_value Tp>
+    [[nodiscard]] auto get_if() noexcept -> Tp* {
+        return std::get_if<Tp>(&_value);
     }
 
+    template <is_node_value Tp>
+    [[nodiscard]] auto get_if() const noexcept -> const Tp* {
+        return std::get_if<Tp>(&_value);
+    }
+
+    template <is_node_value Tp>
+    [[nodiscard]] auto get() -> Tp& {
+        if (const auto value = get_if<Tp>()) return *value;
+        throw node_exception(std::format(
+            "cannot access node holding type index {} as {}", _value.index(),
+            typeid(Tp).name()));
+    }
+
+    template <is_node_value Tp>
+    [[nodiscard]] auto get() const -> const Tp& {
+        if (const auto value = get_if<Tp>()) return *value;
+        throw node_exception(std::format(
+            "cannot access node holding type index {} as {}", _value.index(),
+            typeid(Tp).name()));
+    }
+
+    [[nodiscard]] auto items() -> array&;
+    [[nodiscard]] auto items() const -> const array&;
+    [[nodiscard]] auto span() const -> std::span<const node>;
+    [[nodiscard]] auto fields() -> object&;
+    [[nodiscard]] auto fields() const -> const object&;
+    // owned and borrowed strings alike, without copying
+    [[nodiscard]] auto string() const -> std::string_view;
+
     auto at(uint idx) -> node&;
     auto at(uint idx) const -> const node&;
-    auto field(std::string key) -> node&;
-    auto field(std::string key) const -> const node&;
+    auto field(std::string_view key) -> node&;
+    auto field(std::string_view key) const -> const node&;
+    auto field(symbol key) const -> const node&;
 
    private:
-    template <is_node_convertible Tp>
-    auto _set_value(Tp value) -> void {
-        if (std::is_same_v<void*, Tp>) {
-            _tag = node_tag::JsonNull;
-            _value = (void*)NULL;
-        } else if (std::is_same_v<bool, Tp>) {
-            _tag = node_tag::JsonBool;
-            _value = value;
-        } else if (std::is_same_v<int, Tp>) {
-            _tag = node_tag::JsonInt;
-            _value = value;
-        } else if (std::is_same_v<float, Tp>) {
-            _tag = node_tag::JsonFloat;
-            _value = value;
-        } else if (std::is_same_v<std::string, Tp>) {
-            _tag = node_tag::JsonString;
-            _value = value;
-        } else if (std::is_same_v<array, Tp>) {
-            _tag = node_tag::JsonArray;
-            _value = value;
-        } else if (std::is_same_v<object, Tp>) {
-            _tag = node_tag::JsonObject;
-            _value = value;
+    template <class Tp>
+    static auto _stored(Tp&& value) -> decltype(auto) {
+        using type = std::remove_cvref_t<Tp>;
+        if constexpr (std::is_floating_point_v<type>)
+            return static_cast<double>(value);
+        else if constexpr (is_node_number<type> && std::is_signed_v<type>)
+            return static_cast<std::int64_t>(value);
+        else if constexpr (is_node_number<type>)
+            return static_cast<std::uint64_t>(value);
+        else
+            return std::forward<Tp>(value);
+    }
+
+    template <class Tp>
+    [[nodiscard]] auto _number() const -> Tp {
+        if (const auto raw = std::get_if<raw_number>(&_value))
+            return _parse_raw<Tp>(raw->lexeme);
+
+        if constexpr (std::is_floating_point_v<Tp>) {
+            if (const auto value = std::get_if<double>(&_value))
+                return static_cast<Tp>(*value);
+            if (const auto value = std::get_if<std::int64_t>(&_value))
+                return static_cast<Tp>(*value);
+            if (const auto value = std::get_if<std::uint64_t>(&_value))
+                return static_cast<Tp>(*value);
+        } else {
+            if (const auto value = std::get_if<std::int64_t>(&_value);
+                value && std::in_range<Tp>(*value))
+                return static_cast<Tp>(*value);
+            if (const auto value = std::get_if<std::uint64_t>(&_value);
+                value && std::in_range<Tp>(*value))
+                return static_cast<Tp>(*value);
+        }
+        _throw_number(typeid(Tp).name());
+    }
+
+    template <class Tp>
+    [[nodiscard]] auto _parse_raw(std::string_view lexeme) const -> Tp {
+        if constexpr (std::is_floating_point_v<Tp>) {
+            return static_cast<Tp>(_parse_double(lexeme));
         } else {
-            throw std::logic_error(
-                std::format(
-                    "unreachable: constructor for type {} is not implemented",
-                    typeid(Tp).name())
-                    .c_str());
+            Tp value{};
+            const auto last{lexeme.data() + lexeme.size()};
+            if (const auto res = std::from_chars(lexeme.data(), last, value);
+                res.ec != std::errc{} || res.ptr != last)
+                _throw_number(typeid(Tp).name());
+            return value;
         }
     }
 
+    [[nodiscard]] static auto _parse_double(std::string_view lexeme)
+        -> double;
+    [[noreturn]] auto _throw_number(const char* type) const -> void;
+
+    template <class Tp>
+    static consteval auto _tag_of() -> node_tag {
+        if constexpr (std::is_same_v<void*, Tp>)
+            return node_tag::JsonNull;
+        else if constexpr (std::is_same_v<bool, Tp>)
+            return node_tag::JsonBool;
+        else if constexpr (std::is_floating_point_v<Tp>)
+            return node_tag::JsonFloat;
+        else if constexpr (is_node_number<Tp>)
+            return node_tag::JsonInt;
+        else if constexpr (std::is_same_v<std::string, Tp> ||
+                           std::is_same_v<std::string_view, Tp>)
+            return node_tag::JsonString;
+        else if constexpr (std::is_same_v<array, Tp>)
+            return node_tag::JsonArray;
+        else if constexpr (std::is_same_v<object, Tp>)
+            return node_tag::JsonObject;
+        else
+            static_assert(!sizeof(Tp),
+                          "constructor for this type is not implemented");
+    }
+
    private:
     node_tag _tag{node_tag::JsonNull};
     value_t _value{(void*)NULL};
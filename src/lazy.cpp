@@ -0,0 +1,237 @@
+#include "lazy.hpp"
+
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "simd.hpp"
+
+namespace json {
+/* lazy_cursor implementation */
+lazy_cursor::lazy_cursor(const lazy_document* document,
+                         std::size_t idx) noexcept
+    : _document(document), _idx(idx) {}
+
+auto lazy_cursor::tag() const -> node_tag {
+    switch (_document->_char(_idx)) {
+        case '[':
+            return node_tag::JsonArray;
+        case '{':
+            return node_tag::JsonObject;
+        case '"':
+            return node_tag::JsonString;
+        case 't':
+        case 'f':
+            return node_tag::JsonBool;
+        case 'n':
+            return node_tag::JsonNull;
+        default:
+            // integers and floats are only told apart by parsing them
+            return materialize().tag();
+    }
+}
+
+auto lazy_cursor::size() const -> std::size_t {
+    const auto open{_document->_char(_idx)};
+    if (open != '[' && open != '{')
+        throw node_exception("cannot get the size of non-container nodes");
+
+    const auto close{open == '[' ? ']' : '}'};
+    std::size_t retval{0};
+    for (auto idx{_idx + 1}; _document->_char(idx) != close; retval++) {
+        _document->_expect_value(open == '{' ? idx + 2 : idx);
+        idx = _document->_next(open == '{' ? idx + 2 : idx);
+        _document->_expect_separator(idx, close);
+    }
+    return retval;
+}
+
+auto lazy_cursor::at(uint idx) const -> lazy_cursor {
+    if (_document->_char(_idx) != '[')
+        throw node_exception("cannot access non-array nodes items");
+
+    uint count{0};
+    for (auto item{_idx + 1}; _document->_char(item) != ']'; count++) {
+        _document->_expect_value(item);
+        if (count == idx) return {_document, item};
+
+        item = _document->_next(item);
+        _document->_expect_separator(item, ']');
+    }
+
+    throw std::out_of_range(
+        std::format("index out of range: node field size {} ({} was given)",
+                    count, idx));
+}
+
+auto lazy_cursor::field(std::string_view key) const -> lazy_cursor {
+    if (_document->_char(_idx) != '{')
+        throw node_exception("cannot access non-object nodes fields");
+
+    const auto& source{_document->_source};
+    std::string decoded{};
+    for (auto idx{_idx + 1}; _document->_char(idx) != '}';) {
+        auto position{std::size_t{_document->_index[idx]}};
+        if (source[position] != '"' || _document->_char(idx + 1) != ':')
+            throw invalid_json_exception(std::format(
+                "expected key followed by `:` at position {}", position));
+
+        const auto value{idx + 2};
+        _document->_expect_value(value);
+        const auto raw{scan_string(source, position)};
+        if (decode_string(raw, decoded, position - raw.size() - 1) == key)
+            return {_document, value};
+
+        idx = _document->_next(value);
+        _document->_expect_separator(idx, '}');
+    }
+
+    throw std::out_of_range(std::format("key `{}` not in dictionary", key));
+}
+
+auto lazy_cursor::materialize() const -> const node& {
+    auto& cache{_document->_cache};
+    if (const auto it = cache.find(_idx); it != cache.end()) return it->second;
+
+    return cache.emplace(_idx, _parse()).first->second;
+}
+
+auto lazy_cursor::_parse() const -> node {
+    const auto& source{_document->_source};
+    const auto begin{std::size_t{_document->_index[_idx]}};
+    const auto ch{source[begin]};
+
+    if (ch == '[' || ch == '{') {
+        const auto end{std::size_t{_document->_index[_document->_close[_idx]]}};
+        return deserialize(source.substr(begin, end - begin + 1),
+                           {.borrow_strings = true});
+    }
+
+    auto idx{begin};
+    node retval{};
+    if (ch == '"') {
+        std::string decoded{};
+        const auto raw{scan_string(source, idx)};
+        if (const auto value = decode_string(raw, decoded, begin + 1);
+            value.data() == raw.data())
+            retval = node{value};
+        else
+            retval = node{std::move(decoded)};
+    } else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+        retval = std::visit([](auto value) { return node{value}; },
+                            scan_number(source, idx));
+    } else if (const auto literal = scan_literal(source, idx);
+               literal == "true" || literal == "false") {
+        retval = node{literal == "true"};
+    } else if (literal != "null") {
+        throw invalid_json_exception(std::format(
+            "unexpected literal `{}` at position {}", literal, begin));
+    }
+
+    // nothing but whitespace may follow the scalar up to the next token
+    const auto next{_idx + 1 < _document->_index.size()
+                        ? std::size_t{_document->_index[_idx + 1]}
+                        : source.size()};
+    while (idx < next && is_whitespace(source[idx])) idx++;
+    if (idx != next)
+        throw invalid_json_exception(
+            std::format("unexpected character at position {}", idx));
+
+    return retval;
+}
+
+/* lazy_document implementation */
+auto lazy_document::root() const -> lazy_cursor {
+    return {this, 0};
+}
+
+auto lazy_document::_char(std::size_t idx) const noexcept -> char {
+    return _source[_index[idx]];
+}
+
+auto lazy_document::_next(std::size_t idx) const noexcept -> std::size_t {
+    const auto ch{_char(idx)};
+    return ch == '[' || ch == '{' ? _close[idx] + 1 : idx + 1;
+}
+
+auto lazy_document::_expect_value(std::size_t idx) const -> void {
+    switch (_char(idx)) {
+        case ',':
+        case ':':
+        case ']':
+        case '}':
+            throw invalid_json_exception(
+                std::format("expected value at position {}", _index[idx]));
+        default:
+            break;
+    }
+}
+
+auto lazy_document::_expect_separator(std::size_t& idx, char close) const
+    -> void {
+    if (_char(idx) == close) return;
+    if (_char(idx) != ',')
+        throw invalid_json_exception(std::format(
+            "expected `,` or `{}` at position {}", close, _index[idx]));
+
+    // a comma is always followed by the close bracket at least
+    _expect_value(++idx);
+}
+
+auto deserialize_lazy(std::string_view content) -> lazy_document {
+    lazy_document retval{};
+    retval._source = content;
+    if (!build_structural_index(content, retval._index))
+        throw invalid_json_exception(
+            "document too large for a structural index");
+
+    if (retval._index.empty() ||
+        (content[retval._index[0]] != '[' && content[retval._index[0]] != '{'))
+        throw invalid_json_exception("root value must be an array or object");
+
+    // match the brackets, which is all the validation done upfront
+    auto& index{retval._index};
+    retval._close.assign(index.size(), 0);
+    std::vector<std::uint32_t> open{};
+    for (std::uint32_t idx{0}; idx < index.size(); idx++) {
+        switch (const auto ch = content[index[idx]]) {
+            case '[':
+            case '{':
+                if (open.empty() && idx != 0)
+                    throw invalid_json_exception(std::format(
+                        "unexpected content after the root value at "
+                        "position {}",
+                        index[idx]));
+                open.push_back(idx);
+                break;
+
+            case ']':
+            case '}':
+                if (open.empty() ||
+                    content[index[open.back()]] != (ch == ']' ? '[' : '{'))
+                    throw invalid_json_exception(std::format(
+                        "unexpected `{}` at position {}", ch, index[idx]));
+                retval._close[open.back()] = idx;
+                open.pop_back();
+                break;
+
+            default:
+                if (open.empty())
+                    throw invalid_json_exception(std::format(
+                        "unexpected content after the root value at "
+                        "position {}",
+                        index[idx]));
+        }
+    }
+
+    if (!open.empty())
+        throw invalid_json_exception(
+            std::format("unclosed bracket found, opened at position {}",
+                        index[open.back()]));
+
+    return retval;
+}
+}  // namespace json
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "json.hpp"
+
+namespace json {
+class lazy_document;
+
+// handle to a value of a lazy document, navigating only skips over the
+// structural index while values are parsed when they are read
+class lazy_cursor final {
+   public:
+    [[nodiscard]] auto tag() const -> node_tag;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    template <is_node_convertible Tp>
+    [[nodiscard]] auto value() const -> Tp {
+        return materialize().value<Tp>();
+    }
+
+    [[nodiscard]] auto at(uint idx) const -> lazy_cursor;
+    [[nodiscard]] auto field(std::string_view key) const -> lazy_cursor;
+
+    // parses the value on first use, later calls return the cached node
+    [[nodiscard]] auto materialize() const -> const node&;
+
+   private:
+    friend class lazy_document;
+    lazy_cursor(const lazy_document* document, std::size_t idx) noexcept;
+
+    [[nodiscard]] auto _parse() const -> node;
+
+   private:
+    const lazy_document* _document;
+    std::size_t _idx;
+};
+
+// borrows the source and only checks that its brackets are balanced, the
+// grammar of a value is validated when it is parsed; parsed values are cached
+// so the document is not safe to share between threads
+class lazy_document final {
+   public:
+    lazy_document() noexcept = default;
+
+    [[nodiscard]] auto root() const -> lazy_cursor;
+
+   private:
+    friend class lazy_cursor;
+    friend auto deserialize_lazy(std::string_view content) -> lazy_document;
+
+    [[nodiscard]] auto _char(std::size_t idx) const noexcept -> char;
+    [[nodiscard]] auto _next(std::size_t idx) const noexcept -> std::size_t;
+    auto _expect_value(std::size_t idx) const -> void;
+    auto _expect_separator(std::size_t& idx, char close) const -> void;
+
+   private:
+    std::string_view _source{};
+    std::vector<std::uint32_t> _index{};
+    // entry of the matching close bracket for every open one
+    std::vector<std::uint32_t> _close{};
+    mutable std::unordered_map<std::size_t, node> _cache{};
+};
+
+[[nodiscard]]
+auto deserialize_lazy(std::string_view content) -> lazy_document;
+}  // namespace json
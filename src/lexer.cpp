@@ -0,0 +1,317 @@
+#include "lexer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <system_error>
+
+#include "simd.hpp"
+
+namespace json {
+auto is_digit(std::string_view source, std::size_t idx) noexcept -> bool {
+    return idx < source.size() && source[idx] >= '0' && source[idx] <= '9';
+}
+
+// powers of ten exactly representable as doubles
+constexpr double exactPowers[]{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                               1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                               1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr std::uint64_t exactMantissa{std::uint64_t{1} << 53};
+constexpr int maxDigits{19};
+
+auto scan_number(std::string_view source, std::size_t& idx, bool& outOfRange)
+    -> number_t {
+    outOfRange = false;
+    const auto startIdx{idx};
+    const bool negative{idx < source.size() && source[idx] == '-'};
+
+    if (negative) idx++;
+    if (!is_digit(source, idx))
+        throw invalid_json_exception(
+            std::format("expected digit in number at position {}", idx));
+
+    // significant digits are accumulated while scanning, numbers with more
+    // than fit a 64 bits mantissa go through `from_chars`
+    std::uint64_t mantissa{0};
+    int digits{0};
+    int exponent{0};
+    const auto accumulate{[&](char ch) {
+        if (mantissa == 0 && ch == '0') return;
+        if (++digits <= maxDigits)
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(ch - '0');
+    }};
+
+    if (source[idx] == '0') {
+        if (is_digit(source, ++idx))
+            throw invalid_json_exception(std::format(
+                "leading zeros are not allowed in number at position {}",
+                startIdx));
+    } else {
+        while (is_digit(source, idx)) accumulate(source[idx++]);
+    }
+
+    bool isInteger{true};
+    if (idx < source.size() && source[idx] == '.') {
+        isInteger = false;
+        if (!is_digit(source, ++idx))
+            throw invalid_json_exception(std::format(
+                "expected digit after decimal point at position {}", idx));
+
+        while (is_digit(source, idx)) {
+            accumulate(source[idx++]);
+            exponent--;
+        }
+    }
+
+    if (idx < source.size() && (source[idx] == 'e' || source[idx] == 'E')) {
+        isInteger = false;
+        idx++;
+        bool negativeExponent{false};
+        if (idx < source.size() && (source[idx] == '+' || source[idx] == '-'))
+            negativeExponent = source[idx++] == '-';
+
+        if (!is_digit(source, idx))
+            throw invalid_json_exception(std::format(
+                "expected digit in number exponent at position {}", idx));
+
+        int value{0};
+        // larger exponents are out of range either way
+        while (is_digit(source, idx))
+            if (const auto digit{source[idx++] - '0'}; value < 100'000)
+                value = value * 10 + digit;
+        exponent += negativeExponent ? -value : value;
+    }
+
+    const auto first{source.data() + startIdx};
+    const auto last{source.data() + idx};
+    if (isInteger && digits <= maxDigits) {
+        if (!negative)
+            return mantissa <= std::numeric_limits<std::int64_t>::max()
+                       ? number_t{static_cast<std::int64_t>(mantissa)}
+                       : number_t{mantissa};
+        if (mantissa <= std::uint64_t{1} << 63)
+            return static_cast<std::int64_t>(0 - mantissa);
+    } else if (isInteger && !negative) {
+        std::uint64_t value{};
+        if (std::from_chars(first, last, value).ec == std::errc{}) return value;
+    }
+
+    // exact mantissa and power of ten, a single correctly rounded operation
+    if (digits <= maxDigits && mantissa <= exactMantissa && exponent >= -22 &&
+        exponent <= 22) {
+        auto value{static_cast<double>(mantissa)};
+        value = exponent < 0 ? value / exactPowers[-exponent]
+                             : value * exactPowers[exponent];
+        return negative ? -value : value;
+    }
+
+    // integers that do not fit 64 bits are kept as doubles
+    double value{};
+    if (std::from_chars(first, last, value).ec == std::errc{}) return value;
+
+    // `from_chars` only fails on magnitudes rounding to zero or infinity,
+    // the position of the first significant digit tells them apart
+    outOfRange = true;
+    value = digits + exponent > 0 ? std::numeric_limits<double>::infinity()
+                                  : 0.0;
+    return negative ? -value : value;
+}
+
+auto scan_number(std::string_view source, std::size_t& idx) -> number_t {
+    const auto startIdx{idx};
+    bool outOfRange{};
+    const auto number{scan_number(source, idx, outOfRange)};
+    if (outOfRange && std::isinf(std::get<double>(number)))
+        throw_number_overflow(source.substr(startIdx, idx - startIdx),
+                              startIdx);
+    return number;
+}
+
+auto throw_number_overflow(std::string_view lexeme, std::size_t position)
+    -> void {
+    throw invalid_json_exception(std::format(
+        "number `{}` out of range at position {}", lexeme, position));
+}
+
+auto scan_string(std::string_view source, std::size_t& idx)
+    -> std::string_view {
+    const auto startIdx{idx++};
+
+    // runs without quotes, backslashes or control characters are skipped
+    // 16 bytes at a time
+    while ((idx += find_escape(source.substr(idx))) < source.size()) {
+        switch (source[idx]) {
+            case '"':
+                return source.substr(startIdx + 1, idx++ - startIdx - 1);
+
+            case '\\':
+                // a trailing backslash leaves the string unclosed
+                idx = std::min(idx + 2, source.size());
+                break;
+
+            default:
+                throw invalid_json_exception(std::format(
+                    "unescaped control character in string at position {}",
+                    idx));
+        }
+    }
+
+    throw invalid_json_exception(std::format(
+        "unclosed string found, opened at position {}", startIdx));
+}
+
+auto throw_invalid_utf8(std::size_t position) -> void {
+    throw invalid_json_exception(
+        std::format("invalid utf-8 sequence in string at position {}",
+                    position));
+}
+
+auto validate_utf8(std::string_view value, std::size_t position) -> void {
+    const auto byte{[&](std::size_t idx) {
+        return idx < value.size() ? static_cast<unsigned char>(value[idx])
+                                  : 0u;
+    }};
+    const auto continuation{[](unsigned ch) { return (ch & 0xC0) == 0x80; }};
+
+    std::size_t idx{0};
+    while ((idx += find_non_ascii(value.substr(idx))) < value.size()) {
+        const auto lead{byte(idx)};
+        // the second byte is range checked to reject overlong encodings,
+        // surrogates and code points past U+10FFFF
+        unsigned low{0x80}, high{0xBF}, length{0};
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            if (lead == 0xE0) low = 0xA0;
+            if (lead == 0xED) high = 0x9F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            if (lead == 0xF0) low = 0x90;
+            if (lead == 0xF4) high = 0x8F;
+        } else {
+            throw_invalid_utf8(position + idx);
+        }
+
+        if (byte(idx + 1) < low || byte(idx + 1) > high)
+            throw_invalid_utf8(position + idx);
+        for (unsigned i{2}; i < length; i++)
+            if (!continuation(byte(idx + i)))
+                throw_invalid_utf8(position + idx);
+        idx += length;
+    }
+}
+
+auto append_utf8(std::string& out, std::uint32_t code) -> void {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | code >> 6);
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | code >> 12);
+        out += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | code >> 18);
+        out += static_cast<char>(0x80 | (code >> 12 & 0x3F));
+        out += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+// the four hex digits of a unicode escape, starting at `idx`
+auto read_hex4(std::string_view raw, std::size_t idx, std::size_t position)
+    -> std::uint32_t {
+    std::uint32_t value{};
+    if (idx + 4 > raw.size() ||
+        std::from_chars(raw.data() + idx, raw.data() + idx + 4, value, 16)
+                .ptr != raw.data() + idx + 4)
+        throw invalid_json_exception(std::format(
+            "expected four hex digits in unicode escape at position {}",
+            position + idx));
+    return value;
+}
+
+auto decode_string(std::string_view raw, std::string& out,
+                   std::size_t position) -> std::string_view {
+    validate_utf8(raw, position);
+
+    auto run{raw.find('\\')};
+    if (run == std::string_view::npos) return raw;
+
+    out.clear();
+    std::size_t idx{0};
+    while (run != std::string_view::npos) {
+        out.append(raw.data() + idx, run - idx);
+        idx = run + 2;
+
+        switch (const auto escape = raw[run + 1]) {
+            case '"':
+            case '\\':
+            case '/':
+                out += escape;
+                break;
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+
+            case 'u': {
+                auto code{read_hex4(raw, idx, position)};
+                idx += 4;
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    // a high surrogate must be followed by an escaped low one
+                    const auto low{raw.substr(idx, 2) == "\\u"
+                                       ? read_hex4(raw, idx + 2, position)
+                                       : 0};
+                    if (low < 0xDC00 || low > 0xDFFF)
+                        throw invalid_json_exception(std::format(
+                            "unpaired surrogate in unicode escape at "
+                            "position {}",
+                            position + run));
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    idx += 6;
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    throw invalid_json_exception(std::format(
+                        "unpaired surrogate in unicode escape at position {}",
+                        position + run));
+                }
+                append_utf8(out, code);
+                break;
+            }
+
+            default:
+                throw invalid_json_exception(
+                    std::format("invalid escape sequence `\\{}` at position {}",
+                                escape, position + run));
+        }
+        run = raw.find('\\', idx);
+    }
+    out.append(raw.data() + idx, raw.size() - idx);
+    return out;
+}
+
+auto scan_literal(std::string_view source, std::size_t& idx)
+    -> std::string_view {
+    const auto startIdx{idx};
+    while (idx < source.size() && isalpha(source[idx])) idx++;
+
+    return source.substr(startIdx, idx - startIdx);
+}
+}  // namespace json
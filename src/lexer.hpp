@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace json {
+class invalid_json_exception final : public std::exception {
+   public:
+    invalid_json_exception(const std::string& msg) : _msg(msg) {}
+    auto what() const noexcept -> const char* {
+        return _msg.c_str();
+    }
+
+   private:
+    const std::string _msg{};
+};
+
+// integers that fit 64 bits keep their exact value, unsigned only above the
+// signed range; everything else is a correctly rounded double
+using number_t = std::variant<std::int64_t, std::uint64_t, double>;
+
+[[nodiscard]] constexpr auto is_whitespace(char ch) noexcept -> bool {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+// numbers past the range of a double are rounded to zero or infinity and
+// set `outOfRange`, the caller keeps their lexeme or rejects them
+[[nodiscard]]
+auto scan_number(std::string_view source, std::size_t& idx, bool& outOfRange)
+    -> number_t;
+// underflows are rounded to zero, overflows are rejected
+[[nodiscard]]
+auto scan_number(std::string_view source, std::size_t& idx) -> number_t;
+[[noreturn]]
+auto throw_number_overflow(std::string_view lexeme, std::size_t position)
+    -> void;
+// raw body of the string opening at `idx`, escapes are left in place and
+// unescaped control characters are rejected
+[[nodiscard]]
+auto scan_string(std::string_view source, std::size_t& idx)
+    -> std::string_view;
+// validates the utf-8 of a raw string body found at `position` and decodes
+// its escapes, surrogate pairs included; `raw` itself is returned when it
+// holds no escape, the decoded bytes are written to `out` otherwise
+[[nodiscard]]
+auto decode_string(std::string_view raw, std::string& out,
+                   std::size_t position) -> std::string_view;
+// rejects malformed utf-8, `position` is the offset of `value` in the source
+auto validate_utf8(std::string_view value, std::size_t position) -> void;
+[[nodiscard]]
+auto scan_literal(std::string_view source, std::size_t& idx)
+    -> std::string_view;
+}  // namespace json
@@ -0,0 +1,87 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#include "lexer.hpp"
+
+/* mapped_file implementation */
+namespace json {
+mapped_file::mapped_file(const char* filepath, map_access access) {
+    const auto fd{open(filepath, O_RDONLY | O_CLOEXEC)};
+    if (fd == -1)
+        throw invalid_json_exception(std::format(
+            "cannot open file `{}`: {}", filepath, std::strerror(errno)));
+
+    struct stat info {};
+    if (fstat(fd, &info) == -1) {
+        const auto err{errno};
+        close(fd);
+        throw invalid_json_exception(std::format(
+            "cannot stat file `{}`: {}", filepath, std::strerror(err)));
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size == 0) {
+        close(fd);
+        return;
+    }
+
+    const auto addr{mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0)};
+    const auto err{errno};
+    close(fd);
+    if (addr == MAP_FAILED) {
+        _size = 0;
+        throw invalid_json_exception(std::format(
+            "cannot map file `{}`: {}", filepath, std::strerror(err)));
+    }
+
+    if (access == map_access::Sequential) {
+        // the parser reads the content front to back exactly once
+        madvise(addr, _size, MADV_SEQUENTIAL);
+        madvise(addr, _size, MADV_WILLNEED);
+    } else {
+        // lookups touch a few pages, read ahead would fault in the rest
+        madvise(addr, _size, MADV_RANDOM);
+    }
+    _data = static_cast<const char*>(addr);
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : _data(std::exchange(other._data, nullptr)),
+      _size(std::exchange(other._size, 0)) {}
+
+mapped_file::~mapped_file() {
+    _unmap();
+}
+
+auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file& {
+    if (this != &other) {
+        _unmap();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+auto mapped_file::view() const noexcept -> std::string_view {
+    return {_data, _size};
+}
+
+auto mapped_file::size() const noexcept -> std::size_t {
+    return _size;
+}
+
+auto mapped_file::_unmap() noexcept -> void {
+    if (_data) munmap(const_cast<char*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+}
+}  // namespace json
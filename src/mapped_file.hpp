@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace json {
+// how the pages are expected to be read, passed on to the kernel
+enum class map_access { Sequential, Random };
+
+class mapped_file final {
+   public:
+    mapped_file() noexcept = default;
+    explicit mapped_file(const char* filepath,
+                         map_access access = map_access::Sequential);
+    mapped_file(const mapped_file&) = delete;
+    mapped_file(mapped_file&& other) noexcept;
+    ~mapped_file();
+
+    auto operator=(const mapped_file&) -> mapped_file& = delete;
+    auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view;
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+   private:
+    auto _unmap() noexcept -> void;
+
+   private:
+    const char* _data{nullptr};
+    std::size_t _size{0};
+};
+}  // namespace json
@@ -0,0 +1,108 @@
+#include "ndjson.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <thread>
+
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "workers.hpp"
+
+namespace json {
+constexpr std::size_t batchSize{64};
+
+auto split_records(std::string_view content) -> std::vector<std::string_view> {
+    std::vector<std::string_view> retval{};
+    while (!content.empty()) {
+        const auto end{static_cast<const char*>(
+            std::memchr(content.data(), '\n', content.size()))};
+        const auto length{end ? static_cast<std::size_t>(end - content.data())
+                              : content.size()};
+
+        const auto record{content.substr(0, length)};
+        if (std::any_of(record.begin(), record.end(),
+                        [](char ch) { return !is_whitespace(ch); }))
+            retval.push_back(record);
+
+        content.remove_prefix(std::min(length + 1, content.size()));
+    }
+    return retval;
+}
+
+auto parse_record(std::string_view record, std::size_t idx,
+                  const parse_options& options) -> node {
+    try {
+        return deserialize(record, options);
+    } catch (const invalid_json_exception& ex) {
+        throw invalid_json_exception(
+            std::format("invalid ndjson record {}: {}", idx, ex.what()));
+    }
+}
+
+/* ndjson_batch implementation */
+auto ndjson_batch::size() const noexcept -> std::size_t {
+    return _records.size();
+}
+
+auto ndjson_batch::operator[](std::size_t idx) const -> const node& {
+    return _records.at(idx);
+}
+
+auto ndjson_batch::begin() const noexcept -> std::vector<node>::const_iterator {
+    return _records.begin();
+}
+
+auto ndjson_batch::end() const noexcept -> std::vector<node>::const_iterator {
+    return _records.end();
+}
+
+auto deserialize_ndjson(std::string_view content,
+                        const ndjson_options& options) -> ndjson_batch {
+    const auto records{split_records(content)};
+
+    ndjson_batch retval{};
+    retval._records.resize(records.size());
+    retval._arenas.resize(
+        std::max(1u, options.threads ? options.threads
+                                     : std::thread::hardware_concurrency()));
+    for (auto& arena : retval._arenas) arena = std::make_unique<json::arena>();
+
+    run_workers(records.size(), options.threads, batchSize,
+                [&](std::size_t begin, std::size_t end, uint thread) {
+                    const parse_options parseOptions{
+                        .borrow_strings = options.borrow_strings,
+                        .resource = retval._arenas[thread].get()};
+
+                    for (auto idx{begin}; idx < end; idx++)
+                        retval._records[idx] =
+                            parse_record(records[idx], idx, parseOptions);
+                });
+
+    return retval;
+}
+
+auto for_each_ndjson(
+    std::string_view content,
+    const std::function<void(std::size_t, const node&)>& callback,
+    const ndjson_options& options) -> void {
+    const auto records{split_records(content)};
+
+    run_workers(records.size(), options.threads, batchSize,
+                [&](std::size_t begin, std::size_t end, uint) {
+                    thread_local arena arena{};
+                    const parse_options parseOptions{
+                        .borrow_strings = options.borrow_strings,
+                        .resource = &arena};
+
+                    for (auto idx{begin}; idx < end; idx++) {
+                        {
+                            const auto record{
+                                parse_record(records[idx], idx, parseOptions)};
+                            callback(idx, record);
+                        }
+                        arena.reset();
+                    }
+                });
+}
+}  // namespace json
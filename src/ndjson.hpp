@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "arena.hpp"
+#include "json.hpp"
+
+namespace json {
+struct ndjson_options {
+    // worker threads, one per hardware thread when zero
+    uint threads{0};
+    bool borrow_strings{false};
+};
+
+// records parsed from newline delimited json, in input order; every worker
+// allocates its records from its own arena, which lives as long as the batch
+class ndjson_batch final {
+   public:
+    ndjson_batch() noexcept = default;
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+    [[nodiscard]] auto operator[](std::size_t idx) const -> const node&;
+    [[nodiscard]] auto begin() const noexcept
+        -> std::vector<node>::const_iterator;
+    [[nodiscard]] auto end() const noexcept
+        -> std::vector<node>::const_iterator;
+
+   private:
+    friend auto deserialize_ndjson(std::string_view content,
+                                   const ndjson_options& options)
+        -> ndjson_batch;
+
+    std::vector<std::unique_ptr<arena>> _arenas{};
+    std::vector<node> _records{};
+};
+
+[[nodiscard]]
+auto deserialize_ndjson(std::string_view content,
+                        const ndjson_options& options = {}) -> ndjson_batch;
+
+// `callback` runs concurrently on the worker threads with the index of the
+// record, the node is only valid for the duration of the call
+auto for_each_ndjson(
+    std::string_view content,
+    const std::function<void(std::size_t, const node&)>& callback,
+    const ndjson_options& options = {}) -> void;
+}  // namespace json
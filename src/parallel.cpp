@@ -0,0 +1,165 @@
+#include "parallel.hpp"
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "workers.hpp"
+
+namespace json {
+constexpr auto npos{std::string_view::npos};
+
+struct chunk_summary {
+    // nesting change when the chunk starts outside or inside of a string
+    std::int64_t depthOutside{0};
+    std::int64_t depthInside{0};
+    bool flipsString{false};
+};
+
+struct chunk_state {
+    bool inString{false};
+    std::int64_t depth{0};
+};
+
+auto bracket_delta(char ch) noexcept -> std::int64_t {
+    if (ch == '[' || ch == '{') return 1;
+    if (ch == ']' || ch == '}') return -1;
+    return 0;
+}
+
+// both starting states are tracked at once, a quote flips between them; the
+// boundaries never split an escape so backslashes are skipped alike
+auto summarize(std::string_view chunk) noexcept -> chunk_summary {
+    chunk_summary retval{};
+    bool flipped{false};
+    for (std::size_t idx{0}; idx < chunk.size(); idx++) {
+        const auto ch{chunk[idx]};
+        if (ch == '\\')
+            idx++;
+        else if (ch == '"')
+            flipped = !flipped;
+        else
+            (flipped ? retval.depthInside : retval.depthOutside) +=
+                bracket_delta(ch);
+    }
+    retval.flipsString = flipped;
+    return retval;
+}
+
+// position of the first comma separating root items, npos if there is none
+auto first_separator(std::string_view content, std::size_t begin,
+                     std::size_t end, chunk_state state) noexcept
+    -> std::size_t {
+    for (auto idx{begin}; idx < end; idx++) {
+        const auto ch{content[idx]};
+        if (ch == '\\')
+            idx++;
+        else if (ch == '"')
+            state.inString = !state.inString;
+        else if (!state.inString) {
+            if (ch == ',' && state.depth == 1) return idx;
+            state.depth += bracket_delta(ch);
+        }
+    }
+    return npos;
+}
+
+// `sole` is set when the items are all of the root array, which may be empty
+auto parse_items(std::string_view content, std::size_t separator,
+                 std::size_t end, bool sole) -> array {
+    const auto items{content.substr(separator + 1, end - separator - 1)};
+    if (!sole && items.find_first_not_of(" \t\n\r") == npos)
+        throw invalid_json_exception(
+            std::format("expected value after position {}", separator));
+
+    std::string buffer{};
+    buffer.reserve(items.size() + 2);
+    buffer += '[';
+    buffer += items;
+    buffer += ']';
+
+    try {
+        return std::move(deserialize(buffer).items());
+    } catch (const invalid_json_exception& ex) {
+        throw invalid_json_exception(std::format(
+            "invalid items after position {}: {}", separator, ex.what()));
+    }
+}
+
+auto deserialize_parallel(std::string_view content,
+                          const parallel_options& options) -> node {
+    const auto first{content.find_first_not_of(" \t\n\r")};
+    const auto last{content.find_last_not_of(" \t\n\r")};
+    if (content.size() <= options.chunk_size || first == npos ||
+        content[first] != '[' || content[last] != ']')
+        return deserialize(content);
+
+    // chunk boundaries are moved past backslashes so no escape is split
+    std::vector<std::size_t> bounds{0};
+    for (auto pos{options.chunk_size}; pos < content.size();
+         pos += options.chunk_size) {
+        while (pos < content.size() && content[pos - 1] == '\\') pos++;
+        if (pos < content.size() && pos > bounds.back()) bounds.push_back(pos);
+    }
+    bounds.push_back(content.size());
+    const auto chunks{bounds.size() - 1};
+
+    std::vector<chunk_summary> summaries(chunks);
+    run_workers(chunks, options.threads, 1,
+                [&](std::size_t begin, std::size_t end, uint) {
+                    for (auto idx{begin}; idx < end; idx++)
+                        summaries[idx] = summarize(content.substr(
+                            bounds[idx], bounds[idx + 1] - bounds[idx]));
+                });
+
+    std::vector<chunk_state> states(chunks + 1);
+    for (std::size_t idx{0}; idx < chunks; idx++) {
+        const auto& summary{summaries[idx]};
+        const auto& state{states[idx]};
+        states[idx + 1] = {
+            state.inString != summary.flipsString,
+            state.depth + (state.inString ? summary.depthInside
+                                          : summary.depthOutside)};
+    }
+
+    // unbalanced documents get their error from the sequential parser
+    if (states[chunks].inString || states[chunks].depth != 0)
+        return deserialize(content);
+
+    std::vector<std::size_t> separators(chunks);
+    run_workers(chunks, options.threads, 1,
+                [&](std::size_t begin, std::size_t end, uint) {
+                    for (auto idx{begin}; idx < end; idx++)
+                        separators[idx] = first_separator(
+                            content, bounds[idx], bounds[idx + 1], states[idx]);
+                });
+
+    // the items between consecutive separators are parsed as arrays
+    std::vector<std::size_t> splits{first};
+    for (const auto separator : separators)
+        if (separator != npos) splits.push_back(separator);
+    splits.push_back(last);
+
+    std::vector<array> parts(splits.size() - 1);
+    run_workers(parts.size(), options.threads, 1,
+                [&](std::size_t begin, std::size_t end, uint) {
+                    for (auto idx{begin}; idx < end; idx++)
+                        parts[idx] = parse_items(content, splits[idx],
+                                                 splits[idx + 1],
+                                                 parts.size() == 1);
+                });
+
+    std::size_t count{0};
+    for (const auto& part : parts) count += part.size();
+
+    array retval{};
+    retval.reserve(count);
+    for (auto& part : parts)
+        for (auto& item : part) retval.push_back(std::move(item));
+    return node{std::move(retval)};
+}
+}  // namespace json
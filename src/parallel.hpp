@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+#include "json.hpp"
+
+namespace json {
+struct parallel_options {
+    // worker threads, one per hardware thread when zero
+    uint threads{0};
+    // inputs up to this size are parsed on the calling thread alone
+    std::size_t chunk_size{1 << 20};
+};
+
+// parses a document whose root is an array with its items split between
+// threads: chunks are summarized in parallel (string and nesting changes),
+// a prefix over the summaries gives the state at every chunk start, and the
+// items between the first top level commas of consecutive chunks are parsed
+// concurrently; any other document is parsed sequentially
+[[nodiscard]]
+auto deserialize_parallel(std::string_view content,
+                          const parallel_options& options = {}) -> node;
+}  // namespace json
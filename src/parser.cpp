@@ -1,195 +1,340 @@
 #include "parser.hpp"
 
-#include <cctype>
-#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <format>
-#include <fstream>
-#include <ios>
-#include <iostream>
-#include <regex>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "json.hpp"
+#include "lexer.hpp"
+#include "mapped_file.hpp"
+#include "reader.hpp"
+#include "schema.hpp"
+#include "simd.hpp"
 
 namespace json {
-auto parse_array(const std::string& source, uint& idx) -> node;
-auto parse_object(const std::string& source, uint& idx) -> node;
-
-auto parse_value(const std::string& source, uint& idx) -> node {
-    auto startIdx{idx};
-
-    std::string buf{};
-    bool quoted{false};
-    while (const auto& ch = source[idx]) {
-        if (ch == '"') {
-            if (quoted)
-                quoted = false;
-            else {
-                quoted = true;
-                startIdx = idx;
-            }
-        }
-
-        if (!quoted) {
-            if (isspace(ch)) {
-                idx++;
-                continue;
-            }
-
-            if (ch == ',' || ch == ']' || ch == '}') break;
-            if (ch == '[') return parse_array(source, idx);
-            if (ch == '{') return parse_object(source, idx);
-        }
-
-        buf += ch;
-        idx++;
-    }
+auto resource_of(const parse_options& options) noexcept
+    -> std::pmr::memory_resource* {
+    return options.resource ? options.resource
+                            : std::pmr::get_default_resource();
+}
 
-    if (buf.empty())
-        throw invalid_json_exception(std::format(
-            "missing or empty object field value at position {}", startIdx));
-
-    if (buf == "null") return node{};
-    if (buf == "true") return node{true};
-    if (buf == "false") return node{false};
-    if (std::regex_match(buf, std::regex("^[+-]?[0-9]+$")))
-        return node{std::stoi(buf)};
-    if (std::regex_match(buf, std::regex("^[+-]?[0-9]+(?:\\.[0-9]+)?$")))
-        return node{std::stof(buf)};
-    if (buf[0] == '"') {
-        if (quoted)
-            throw invalid_json_exception(std::format(
-                "unclosed object field value found, opened at position {}",
-                startIdx));
-
-        return node{buf.substr(1, buf.length() - 2)};
-    }
+auto copy_string(std::string_view value, std::pmr::memory_resource* resource)
+    -> std::string_view {
+    if (value.empty()) return {};
 
-    throw invalid_json_exception(
-        std::format("cannot parse object field value `{}` "
-                    "at position {}",
-                    buf, startIdx));
+    auto data{static_cast<char*>(resource->allocate(value.size(), 1))};
+    std::memcpy(data, value.data(), value.size());
+    return {data, value.size()};
 }
 
-auto parse_array(const std::string& source, uint& idx) -> node {
-    const auto startIdx{idx};
+// 17 significant digits always survive a round trip through a double
+auto is_lossy(std::string_view lexeme) noexcept -> bool {
+    const auto end{lexeme.find_first_of("eE")};
+    if (end == std::string_view::npos && lexeme.find('.') == lexeme.npos)
+        return true;
 
-    array retval{};
-    uint itemsCount{0};
-    bool isClosed{false};
-    while (const auto& ch = source[++idx]) {
-        if (isspace(ch) || ch == '\r' || ch == '\n') continue;
-        if (ch == ']') {
-            isClosed = true;
-            break;
-        }
+    std::size_t digits{0};
+    for (const auto ch : lexeme.substr(0, end))
+        if ((ch >= '1' && ch <= '9') || (ch == '0' && digits > 0)) digits++;
+    return digits > 17;
+}
 
-        if (ch == ',') {
-            if (itemsCount != 0) continue;
-            throw invalid_json_exception(
-                std::format("item separator found with no previous item "
-                            "declared at position {}",
-                            idx));
+/* node_builder implementation */
+node_builder::node_builder(const parse_options& options) noexcept
+    : _options(options) {}
+
+auto node_builder::push(event_tag event, const reader& reader) -> bool {
+#ifdef JSON_PARSE_STATS
+    if (_options.stats) _record(event, reader);
+#endif
+    const auto resource{resource_of(_options)};
+    switch (event) {
+        case event_tag::JsonNull:
+            return _insert(node{});
+
+        case event_tag::JsonBool:
+            return _insert(node{reader.boolean()});
+
+        case event_tag::JsonNumber:
+            if (_options.raw_numbers &&
+                std::holds_alternative<double>(reader.number()) &&
+                (reader.out_of_range() || is_lossy(reader.string())))
+                return _insert(node{raw_number{std::string{reader.string()}}});
+            // underflows are kept as zero
+            if (reader.out_of_range() &&
+                std::isinf(std::get<double>(reader.number())))
+                throw_number_overflow(reader.string(), reader.position());
+            return _insert(std::visit([](auto value) { return node{value}; },
+                                      reader.number()));
+
+        case event_tag::JsonString:
+            // decoded strings live in the reader, they cannot be borrowed
+            if (_options.borrow_strings && !reader.escaped())
+                return _insert(node{reader.string()});
+            else if (_options.resource)
+                return _insert(node{copy_string(reader.string(), resource)});
+            else
+                return _insert(node{std::string{reader.string()}});
+
+        case event_tag::ArrayStart:
+        case event_tag::ObjectStart:
+            _stack.push_back({event == event_tag::ObjectStart,
+                              array(resource), object(resource),
+                              object_key{std::string_view{}, resource}, 0});
+            return false;
+
+        case event_tag::ObjectKey: {
+            auto& top{_stack.back()};
+            if (_options.symbols)
+                top.key = object_key{_options.symbols->intern(reader.string()),
+                                     resource};
+            else
+                top.key = object_key{reader.string(), resource};
+            top.keyPosition = reader.position();
+            return false;
         }
 
-        retval.push_back(parse_value(source, idx));
-        itemsCount++;
-
-        if (source[idx] == ']' && retval.back().tag() != node_tag::JsonArray) {
-            isClosed = true;
-            break;
+        case event_tag::ArrayEnd:
+        case event_tag::ObjectEnd: {
+            auto top{std::move(_stack.back())};
+            _stack.pop_back();
+            if (top.isObject) return _insert(node{std::move(top.fields)});
+            return _insert(node{std::move(top.items)});
         }
-    };
 
-    if (!isClosed)
-        throw invalid_json_exception(std::format(
-            "unclosed array found, opened at position {}", startIdx));
+        case event_tag::DocumentEnd:
+        case event_tag::NeedInput:
+            return false;
+    }
+    return false;
+}
 
-    return node{retval};
+auto node_builder::take() -> node {
+    return std::move(_root);
 }
 
-auto parse_object(const std::string& source, uint& idx) -> node {
-    const auto startIdx{idx};
+auto node_builder::reset() noexcept -> void {
+    _stack.clear();
+    _root = node{};
+}
 
-    object retval{};
-    uint itemsCount{0};
-    bool isClosed{false};
-    while (const auto& ch = source[++idx]) {
-        if (isspace(ch) || ch == '\r' || ch == '\n') continue;
-        if (ch == '}') {
-            isClosed = true;
-            break;
-        }
+auto node_builder::_insert(node&& value) -> bool {
+#ifdef JSON_PARSE_STATS
+    if (_options.stats)
+        _options.stats->nodes[static_cast<std::size_t>(value.tag())]++;
+#endif
+    if (_stack.empty()) {
+        _root = std::move(value);
+        return true;
+    }
 
-        if (ch == ',') {
-            if (itemsCount != 0) continue;
-            throw invalid_json_exception(
-                std::format("item separator found with no previous item "
-                            "declared at position {}",
-                            idx));
-        }
+    auto& top{_stack.back()};
+#ifdef JSON_PARSE_STATS
+    const auto capacity{top.isObject ? top.fields.capacity()
+                                     : top.items.capacity()};
+    const auto indexCapacity{top.fields.index_capacity()};
+#endif
+    if (!top.isObject)
+        top.items.push_back(std::move(value));
+    else if (!top.fields.emplace(std::move(top.key), std::move(value)).second)
+        throw invalid_json_exception(std::format(
+            "duplicate key found in object at position {}: `{}`",
+            top.keyPosition, top.key.view()));
+#ifdef JSON_PARSE_STATS
+    if (_options.stats) _record_growth(top, capacity, indexCapacity);
+#endif
+    return false;
+}
 
-        if (ch != '"')
-            throw invalid_json_exception(
-                std::format("expected open quote for object key "
-                            "declaration, but got `{}` at position {}",
-                            ch, idx));
-
-        auto keyStartIdx{idx};
-        std::string key{};
-        bool quoted{true};
-        while (const auto& chKey = source[++idx]) {
-            if (chKey == '"') {
-                quoted = false;
-                break;
+#ifdef JSON_PARSE_STATS
+// strings are sized before they are copied, so their allocations are
+// predicted from the lengths instead of being observed
+auto node_builder::_record(event_tag event, const reader& reader) noexcept
+    -> void {
+    auto& stats{*_options.stats};
+    const auto inlined{std::string{}.capacity()};
+    const auto length{reader.string().size()};
+
+    switch (event) {
+        case event_tag::JsonString:
+            if ((_options.borrow_strings && !reader.escaped()) || length == 0)
+                return;
+            if (_options.resource) {
+                stats.allocations++;
+                stats.allocated_bytes += length;
+            } else if (length > inlined) {
+                stats.allocations++;
+                stats.allocated_bytes += length + 1;
+            }
+            return;
+
+        case event_tag::ObjectKey:
+            // new symbols are copied into the storage of the table
+            if (_options.symbols) {
+                if (length > 0 &&
+                    _options.symbols->find(reader.string()).name.empty()) {
+                    stats.allocations++;
+                    stats.allocated_bytes += length;
+                }
+            } else if (length > inlined) {
+                stats.allocations++;
+                stats.allocated_bytes += length + 1;
             }
+            return;
 
-            key += chKey;
-        }
+        case event_tag::ArrayStart:
+        case event_tag::ObjectStart:
+            stats.max_depth = std::max(stats.max_depth, _stack.size() + 1);
+            return;
 
-        if (quoted)
-            throw invalid_json_exception(
-                std::format("unclosed object key found, opened at position {}",
-                            keyStartIdx));
-
-        if (key.empty())
-            throw invalid_json_exception(std::format(
-                "missing or empty object key at position {}", keyStartIdx));
-
-        while (const auto& ch = source[++idx]) {
-            if (isspace(ch)) continue;
-            if (ch == ':') break;
-            throw invalid_json_exception(std::format(
-                "expected field initialiser operator `:`, but got `{}` "
-                "at position {}",
-                ch, idx));
-        }
+        default:
+            return;
+    }
+}
 
-        if (retval.contains(key))
-            throw invalid_json_exception(std::format(
-                "duplicate key found in object at position {}: `{}`", idx,
-                key));
+auto node_builder::_record_growth(const frame& top, std::size_t capacity,
+                                  std::size_t indexCapacity) noexcept
+    -> void {
+    auto& stats{*_options.stats};
+    if (top.isObject && top.fields.index_capacity() != indexCapacity) {
+        stats.allocations++;
+        stats.allocated_bytes +=
+            top.fields.index_capacity() * sizeof(std::uint64_t);
+    }
+    if (top.isObject && top.fields.capacity() != capacity) {
+        stats.allocations++;
+        stats.allocated_bytes +=
+            top.fields.capacity() * sizeof(object::value_type);
+    } else if (!top.isObject && top.items.capacity() != capacity) {
+        stats.allocations++;
+        stats.allocated_bytes += top.items.capacity() * sizeof(node);
+    }
+}
 
-        retval.emplace(key, parse_value(source, ++idx));
-        itemsCount++;
+// same loop as `parse_root`, with a clock read around every stage
+auto parse_measured(std::string_view content, const parse_options& options)
+    -> node {
+    using clock = std::chrono::steady_clock;
+    const auto since{[](clock::time_point start, clock::time_point end) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end -
+                                                                    start);
+    }};
+
+    auto& stats{*options.stats};
+    stats.bytes += content.size();
+
+    auto start{clock::now()};
+    std::vector<std::uint32_t> index{};
+    auto reader{build_structural_index(content, index)
+                    ? json::reader{content, index}
+                    : json::reader{content}};
+    auto now{clock::now()};
+    stats.index_time += since(start, now);
+
+    node_builder builder{options};
+    std::optional<schema_checker> checker{};
+    if (options.schema) checker.emplace(*options.schema);
+    while (true) {
+        start = now;
+        const auto event{reader.next()};
+        now = clock::now();
+        if (event == event_tag::JsonNumber)
+            stats.number_time += since(start, now);
+        else
+            stats.scan_time += since(start, now);
+
+        if (event == event_tag::DocumentEnd) return builder.take();
+        if (event == event_tag::NeedInput)
+            throw std::logic_error(
+                "unreachable: complete documents never need more input");
+
+        start = now;
+        if (checker) (*checker)(event, reader);
+        builder.push(event, reader);
+        now = clock::now();
+        stats.build_time += since(start, now);
+    }
+}
+#endif
+
+auto parse_root(std::string_view content, const parse_options& options)
+    -> node {
+#ifdef JSON_PARSE_STATS
+    if (options.stats) return parse_measured(content, options);
+#endif
+    std::vector<std::uint32_t> index{};
+    auto reader{build_structural_index(content, index)
+                    ? json::reader{content, index}
+                    : json::reader{content}};
+
+    node_builder builder{options};
+    std::optional<schema_checker> checker{};
+    if (options.schema) checker.emplace(*options.schema);
+    while (true) {
+        switch (const auto event = reader.next()) {
+            case event_tag::DocumentEnd:
+                return builder.take();
+
+            case event_tag::NeedInput:
+                throw std::logic_error(
+                    "unreachable: complete documents never need more input");
+
+            default:
+                if (checker) (*checker)(event, reader);
+                builder.push(event, reader);
+        }
+    }
+}
 
-        // FIXME: last child object
-        if (source[idx] == '}' &&
-            retval.at(key).tag() != node_tag::JsonObject) {
-            isClosed = true;
-            break;
+/* parser implementation */
+parser::parser(const parser_options& options)
+    : _builder({.borrow_strings = options.borrow_strings,
+                .resource = &_arena,
+                .symbols = options.intern_keys ? &_symbols : nullptr}) {}
+
+auto parser::parse(std::string_view content) -> node& {
+    reset();
+    if (build_structural_index(content, _index))
+        _reader.reset(content, _index);
+    else
+        _reader.reset(content);
+
+    while (true) {
+        switch (const auto event = _reader.next()) {
+            case event_tag::DocumentEnd:
+                _root = _builder.take();
+                return _root;
+
+            case event_tag::NeedInput:
+                throw std::logic_error(
+                    "unreachable: complete documents never need more input");
+
+            default:
+                _builder.push(event, _reader);
         }
     }
+}
 
-    if (!isClosed)
-        throw invalid_json_exception(std::format(
-            "unclosed object found, opened at position {}", startIdx));
+auto parser::reset() noexcept -> void {
+    _builder.reset();
+    _root = node{};
+    _arena.reset();
+}
 
-    return node{retval};
+auto parser::symbols() noexcept -> symbol_table& {
+    return _symbols;
 }
 
-auto deserialize_file(const char* filepath) -> node {
+auto map_json_file(const char* filepath) -> mapped_file {
     std::filesystem::path path{filepath};
     if (!std::filesystem::exists(path))
         throw invalid_json_exception(
@@ -199,56 +344,31 @@ auto deserialize_file(const char* filepath) -> node {
         throw invalid_json_exception(
             "the file must have the `.json` extension");
 
-    std::ifstream filestream{path};
-    if (!filestream)
-        throw invalid_json_exception(
-            std::format("cannot open file `{}`", filepath));
-
-    const auto filesize{std::filesystem::file_size(path)};
-    if (filesize == 0) {
-        filestream.close();
+    mapped_file file{filepath};
+    if (file.size() == 0)
         throw invalid_json_exception(
             std::format("the file `{}` is empty", filepath));
-    }
 
-    std::string content{};
-    std::string line{};
-    while (std::getline(filestream, line)) {
-        if (line.empty()) continue;
-        content += line;
-    };
-
-    node root{};
-    uint idx{0};
-    if (content[0] == '[') {
-        root = parse_array(content, idx);
-    } else if (content[0] == '{') {
-        root = parse_object(content, idx);
-    } else {
-        filestream.close();
-        throw invalid_json_exception(
-            std::format("expected array or object declaration as json root, "
-                        "but got `{}`",
-                        content[0]));
-    }
+    return file;
+}
 
-    filestream.close();
-    return root;
+auto deserialize_file(const char* filepath, const parse_options& options)
+    -> node {
+    const auto file{map_json_file(filepath)};
+    auto copied{options};
+    copied.borrow_strings = false;
+    return parse_root(file.view(), copied);
 }
 
-auto deserialize(std::string content) -> node {
-    node root{};
-    uint idx{0};
-    if (content[0] == '[') {
-        root = parse_array(content, idx);
-    } else if (content[0] == '{') {
-        root = parse_object(content, idx);
-    } else
-        throw invalid_json_exception(
-            std::format("expected array or object declaration as json root, "
-                        "but got `{}`",
-                        content[0]));
+auto deserialize_mapped(const char* filepath, const parse_options& options)
+    -> document {
+    document retval{map_json_file(filepath)};
+    retval.root = parse_root(retval.source.view(), options);
+    return retval;
+}
 
-    return root;
+auto deserialize(std::string_view content, const parse_options& options)
+    -> node {
+    return parse_root(content, options);
 }
 }  // namespace json
@@ -1,22 +1,143 @@
 #pragma once
-#include <exception>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
 
+#include "arena.hpp"
 #include "json.hpp"
+#include "lexer.hpp"
+#include "mapped_file.hpp"
+#include "reader.hpp"
+#include "stats.hpp"
+#include "symbols.hpp"
 
 namespace json {
-class invalid_json_exception final : public std::exception {
+class schema;
+
+struct parse_options {
+    // string nodes borrow from the input instead of owning a copy, the
+    // caller must keep the input alive as long as the tree is in use
+    bool borrow_strings{false};
+    // containers, keys and strings are allocated from this resource when set,
+    // strings then borrow from the resource, see `arena`
+    std::pmr::memory_resource* resource{nullptr};
+    // object keys are interned in this table when set, it must outlive the
+    // tree; keys are then compared by address in `node::field(symbol)`
+    symbol_table* symbols{nullptr};
+    // numbers a double cannot hold exactly keep their lexeme, see `raw_number`:
+    // integers beyond 64 bits and decimals with more than 17 digits
+    bool raw_numbers{false};
+    // documents are checked against this schema as they are read, the first
+    // violation is thrown before the tree is complete, see `schema_checker`
+    const json::schema* schema{nullptr};
+    // counters of the parse are added to this when set, see `parse_stats`;
+    // the member exists in every build so the layout does not depend on
+    // JSON_PARSE_STATS, it is ignored by libraries built without it
+    parse_stats* stats{nullptr};
+};
+
+// resource the nodes are allocated from, the default one when unset
+[[nodiscard]]
+auto resource_of(const parse_options& options) noexcept
+    -> std::pmr::memory_resource*;
+// the copy lives as long as the memory of `resource`
+[[nodiscard]]
+auto copy_string(std::string_view value, std::pmr::memory_resource* resource)
+    -> std::string_view;
+
+// assembles a node from reader events, strings are copied unless borrowed
+// so the events may come from a streaming reader
+class node_builder final {
+   public:
+    explicit node_builder(const parse_options& options = {}) noexcept;
+
+    // true once the events of a whole value were pushed
+    auto push(event_tag event, const reader& reader) -> bool;
+    [[nodiscard]] auto take() -> node;
+    // drops a partially built value, the stack capacity is kept
+    auto reset() noexcept -> void;
+
+   private:
+    struct frame {
+        bool isObject;
+        array items;
+        object fields;
+        object_key key;
+        std::size_t keyPosition;
+    };
+
+    auto _insert(node&& value) -> bool;
+    // only defined with JSON_PARSE_STATS
+    auto _record(event_tag event, const reader& reader) noexcept -> void;
+    auto _record_growth(const frame& top, std::size_t capacity,
+                        std::size_t indexCapacity) noexcept -> void;
+
+   private:
+    parse_options _options;
+    std::vector<frame> _stack{};
+    node _root{};
+};
+
+struct parser_options {
+    bool borrow_strings{false};
+    // keys of every document are interned in the table of the parser
+    bool intern_keys{false};
+};
+
+// stateful parser for high rates of small documents: the structural index,
+// the reader scopes, the builder stack, the key table and the arena holding
+// the trees are kept between calls, so steady state parsing does not hit the
+// heap;
+// meant to be used by a single thread, keep one instance per thread
+class parser final {
    public:
-    invalid_json_exception(const std::string& msg) : _msg(msg) {}
-    auto what() const noexcept -> const char* {
-        return _msg.c_str();
-    }
+    explicit parser(const parser_options& options = {});
+    parser(const parser&) = delete;
+    auto operator=(const parser&) -> parser& = delete;
+
+    // the tree is valid until the next call to `parse` or `reset`
+    [[nodiscard]] auto parse(std::string_view content) -> node&;
+    // drops the last tree, its memory is reused by the next document
+    auto reset() noexcept -> void;
+
+    // interned keys, only filled when `intern_keys` is set; they are kept
+    // across documents so field lookups can use symbols resolved once
+    [[nodiscard]] auto symbols() noexcept -> symbol_table&;
 
    private:
-    const std::string _msg{};
+    std::vector<std::uint32_t> _index{};
+    reader _reader{};
+    arena _arena{};
+    symbol_table _symbols{};
+    node_builder _builder;
+    node _root{};
+};
+
+// keeps the mapping alive alongside the tree, so borrowed strings stay valid
+struct document {
+    mapped_file source{};
+    node root{};
 };
 
+// strings are always copied, the mapping is released before returning
 [[nodiscard]]
-auto deserialize_file(const char* filepath) -> node;
+auto deserialize_file(const char* filepath, const parse_options& options = {})
+    -> node;
+[[nodiscard]]
+auto deserialize_mapped(const char* filepath,
+                        const parse_options& options = {}) -> document;
+[[nodiscard]]
+auto deserialize(std::string_view content, const parse_options& options = {})
+    -> node;
+
+template <std::size_t Extent>
 [[nodiscard]]
-auto deserialize(std::string content) -> node;
+auto deserialize(std::span<const char, Extent> content,
+                 const parse_options& options = {}) -> node {
+    return deserialize(std::string_view{content.data(), content.size()},
+                       options);
+}
 }  // namespace json
@@ -0,0 +1,262 @@
+#include "path.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#include "simd.hpp"
+
+namespace json {
+auto parse_index(std::string_view token, std::size_t& index) noexcept
+    -> bool {
+    // no sign, no leading zeros
+    if (token.empty() || (token.size() > 1 && token.front() == '0'))
+        return false;
+
+    const auto res{
+        std::from_chars(token.data(), token.data() + token.size(), index)};
+    return res.ec == std::errc{} && res.ptr == token.data() + token.size();
+}
+
+auto matches_key(const path_step& step, std::string_view key) noexcept
+    -> bool {
+    return step.kind == step_kind::Wildcard ||
+           (step.kind != step_kind::Index && step.key == key);
+}
+
+auto matches_index(const path_step& step, std::size_t index) noexcept
+    -> bool {
+    return step.kind == step_kind::Wildcard ||
+           (step.kind != step_kind::Key && step.index == index);
+}
+
+// calls `visitor` on every match until it returns false
+template <class Node, class Visitor>
+auto walk(std::span<const path_step> steps, Node& value, Visitor& visitor)
+    -> bool {
+    if (steps.empty()) return visitor(value);
+
+    const auto& step{steps.front()};
+    const auto rest{steps.subspan(1)};
+    if (const auto items = value.template get_if<array>()) {
+        if (step.kind == step_kind::Wildcard) {
+            for (auto& item : *items)
+                if (!walk(rest, item, visitor)) return false;
+        } else if (step.kind != step_kind::Key && step.index < items->size()) {
+            return walk(rest, (*items)[step.index], visitor);
+        }
+    } else if (const auto fields = value.template get_if<object>()) {
+        if (step.kind == step_kind::Wildcard) {
+            for (auto& [key, field] : *fields)
+                if (!walk(rest, field, visitor)) return false;
+        } else if (step.kind != step_kind::Index) {
+            if (const auto it = fields->find(step.key); it != fields->end())
+                return walk(rest, it->second, visitor);
+        }
+    }
+    return true;
+}
+
+/* path implementation */
+auto path::pointer(std::string_view expression) -> path {
+    path retval{};
+    if (expression.empty()) return retval;
+    if (expression.front() != '/')
+        throw invalid_path_exception(std::format(
+            "json pointer must start with `/`: `{}`", expression));
+
+    for (std::size_t idx{1}; idx <= expression.size();) {
+        const auto end{std::min(expression.find('/', idx), expression.size())};
+        const auto token{expression.substr(idx, end - idx)};
+
+        auto& step{retval._steps.emplace_back()};
+        for (std::size_t pos{0}; pos < token.size(); pos++) {
+            if (token[pos] != '~') {
+                step.key += token[pos];
+                continue;
+            }
+
+            const auto escape{pos + 1 < token.size() ? token[++pos] : '\0'};
+            if (escape != '0' && escape != '1')
+                throw invalid_path_exception(std::format(
+                    "invalid escape in json pointer at position {}: `{}`",
+                    idx + pos, expression));
+            step.key += escape == '0' ? '~' : '/';
+        }
+
+        if (parse_index(token, step.index)) step.kind = step_kind::KeyOrIndex;
+        idx = end + 1;
+    }
+    return retval;
+}
+
+auto path::jsonpath(std::string_view expression) -> path {
+    const auto fail = [&](std::size_t position) {
+        return invalid_path_exception(std::format(
+            "invalid jsonpath at position {}: `{}`", position, expression));
+    };
+
+    if (expression.empty() || expression.front() != '$') throw fail(0);
+
+    path retval{};
+    for (std::size_t idx{1}; idx < expression.size();) {
+        auto& step{retval._steps.emplace_back()};
+        if (expression[idx] == '.') {
+            const auto end{
+                std::min(expression.find_first_of(".[", idx + 1),
+                         expression.size())};
+            const auto name{expression.substr(idx + 1, end - idx - 1)};
+            if (name.empty()) throw fail(idx);
+
+            if (name == "*")
+                step.kind = step_kind::Wildcard;
+            else
+                step.key = name;
+            idx = end;
+            continue;
+        }
+
+        if (expression[idx] != '[') throw fail(idx);
+        const auto close{expression.find(']', idx)};
+        if (close == std::string_view::npos) throw fail(idx);
+
+        const auto selector{expression.substr(idx + 1, close - idx - 1)};
+        if (selector == "*") {
+            step.kind = step_kind::Wildcard;
+        } else if (selector.size() >= 2 &&
+                   (selector.front() == '\'' || selector.front() == '"') &&
+                   selector.back() == selector.front()) {
+            step.key = selector.substr(1, selector.size() - 2);
+        } else if (parse_index(selector, step.index)) {
+            step.kind = step_kind::Index;
+        } else {
+            throw fail(idx + 1);
+        }
+        idx = close + 1;
+    }
+    return retval;
+}
+
+auto path::steps() const noexcept -> std::span<const path_step> {
+    return _steps;
+}
+
+auto path::find(const node& root) const noexcept -> const node* {
+    const node* retval{nullptr};
+    auto visitor = [&](const node& value) {
+        retval = &value;
+        return false;
+    };
+    walk(std::span<const path_step>{_steps}, root, visitor);
+    return retval;
+}
+
+auto path::find(node& root) const noexcept -> node* {
+    node* retval{nullptr};
+    auto visitor = [&](node& value) {
+        retval = &value;
+        return false;
+    };
+    walk(std::span<const path_step>{_steps}, root, visitor);
+    return retval;
+}
+
+auto path::select(const node& root, std::vector<const node*>& out) const
+    -> void {
+    auto visitor = [&](const node& value) {
+        out.push_back(&value);
+        return true;
+    };
+    walk(std::span<const path_step>{_steps}, root, visitor);
+}
+
+auto path::select(std::string_view content,
+                  const std::function<void(node&&)>& callback,
+                  const parse_options& options) const -> void {
+    std::vector<std::uint32_t> index{};
+    auto reader{build_structural_index(content, index)
+                    ? json::reader{content, index}
+                    : json::reader{content}};
+
+    path_matcher matcher{*this, callback, options};
+    for (auto event{reader.next()}; event != event_tag::DocumentEnd;
+         event = reader.next())
+        matcher(event, reader);
+}
+
+/* path_matcher implementation */
+path_matcher::path_matcher(const path& path,
+                           std::function<void(node&&)> callback,
+                           const parse_options& options)
+    : _path(&path), _callback(std::move(callback)), _builder(options) {}
+
+auto path_matcher::operator()(event_tag event, const reader& reader) -> void {
+    if (_building) {
+        if (!_builder.push(event, reader)) return;
+
+        _building = false;
+        _callback(_builder.take());
+        _after_value();
+        return;
+    }
+
+    switch (event) {
+        case event_tag::ObjectKey: {
+            auto& top{_frames.back()};
+            top.keyMatches =
+                top.onPath &&
+                matches_key(_path->steps()[_frames.size() - 1],
+                            reader.string());
+            return;
+        }
+
+        case event_tag::ArrayEnd:
+        case event_tag::ObjectEnd:
+            _frames.pop_back();
+            _after_value();
+            return;
+
+        case event_tag::DocumentEnd:
+        case event_tag::NeedInput:
+            return;
+
+        default:
+            break;
+    }
+
+    // the value is on the path when its parent is and the step matches it
+    const auto depth{_frames.size()};
+    bool onPath{true};
+    if (depth > 0) {
+        const auto& top{_frames.back()};
+        onPath = top.isObject ? top.keyMatches
+                              : top.onPath &&
+                                    matches_index(_path->steps()[depth - 1],
+                                                  top.index);
+    }
+
+    if (onPath && depth == _path->steps().size()) {
+        if (!_builder.push(event, reader)) {
+            _building = true;
+            return;
+        }
+
+        _callback(_builder.take());
+        _after_value();
+        return;
+    }
+
+    if (event == event_tag::ArrayStart || event == event_tag::ObjectStart)
+        _frames.push_back(
+            {onPath, event == event_tag::ObjectStart, 0, false});
+    else
+        _after_value();
+}
+
+auto path_matcher::_after_value() noexcept -> void {
+    if (!_frames.empty() && !_frames.back().isObject) _frames.back().index++;
+}
+}  // namespace json
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json.hpp"
+#include "parser.hpp"
+#include "reader.hpp"
+
+namespace json {
+class invalid_path_exception final : public std::exception {
+   public:
+    invalid_path_exception(const std::string& msg) : _msg(msg) {}
+    auto what() const noexcept -> const char* {
+        return _msg.c_str();
+    }
+
+   private:
+    const std::string _msg{};
+};
+
+enum class step_kind : uint {
+    Key,
+    Index,
+    // json pointer tokens made of digits address array items and keys alike
+    KeyOrIndex,
+    Wildcard
+};
+
+struct path_step {
+    step_kind kind{step_kind::Key};
+    std::string key{};
+    std::size_t index{0};
+};
+
+// json pointer (rfc 6901) or jsonpath expression compiled once into a list of
+// steps, evaluating it afterwards does not allocate
+class path final {
+   public:
+    path() noexcept = default;
+
+    // "/store/book/0/title", "" addresses the whole document
+    [[nodiscard]] static auto pointer(std::string_view expression) -> path;
+    // "$.store.book[*]['title']", with member, index and wildcard selectors
+    [[nodiscard]] static auto jsonpath(std::string_view expression) -> path;
+
+    [[nodiscard]] auto steps() const noexcept -> std::span<const path_step>;
+
+    // first match in document order, nullptr when nothing matches
+    [[nodiscard]] auto find(const node& root) const noexcept -> const node*;
+    [[nodiscard]] auto find(node& root) const noexcept -> node*;
+    // appends every match in document order
+    auto select(const node& root, std::vector<const node*>& out) const
+        -> void;
+    // walks the events of `content` and only builds nodes for the matches
+    auto select(std::string_view content,
+                const std::function<void(node&&)>& callback,
+                const parse_options& options = {}) const -> void;
+
+   private:
+    std::vector<path_step> _steps{};
+};
+
+// reader event handler building the values matched by a path, it can be
+// given to `reader::feed` or `read_file_events` to query streamed documents
+class path_matcher final {
+   public:
+    path_matcher(const path& path, std::function<void(node&&)> callback,
+                 const parse_options& options = {});
+
+    auto operator()(event_tag event, const reader& reader) -> void;
+
+   private:
+    struct frame {
+        bool onPath;
+        bool isObject;
+        std::size_t index;
+        bool keyMatches;
+    };
+
+    auto _after_value() noexcept -> void;
+
+   private:
+    const path* _path;
+    std::function<void(node&&)> _callback;
+    node_builder _builder;
+    bool _building{false};
+    std::vector<frame> _frames{};
+};
+}  // namespace json
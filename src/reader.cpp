@@ -0,0 +1,286 @@
+#include "reader.hpp"
+
+#include <cctype>
+#include <format>
+
+/* reader implementation */
+namespace json {
+reader::reader() noexcept : _final(false) {}
+
+reader::reader(std::string_view source) noexcept : _source(source) {}
+
+reader::reader(std::string_view source,
+               std::span<const std::uint32_t> index) noexcept
+    : _source(source), _index(index), _indexed(true) {}
+
+auto reader::reset(std::string_view source) noexcept -> void {
+    reset(source, {});
+    _indexed = false;
+}
+
+auto reader::reset(std::string_view source,
+                   std::span<const std::uint32_t> index) noexcept -> void {
+    _source = source;
+    _idx = 0;
+    _position = 0;
+    _index = index;
+    _next = 0;
+    _indexed = true;
+    _state = state::Root;
+    _scopes.clear();
+    _buffer.clear();
+    _offset = 0;
+    _final = true;
+}
+
+auto reader::next() -> event_tag {
+    while (true) {
+        const auto ch{_skip_whitespace()};
+        _position = _idx;
+        if (!_token_complete()) return event_tag::NeedInput;
+
+        switch (_state) {
+            case state::Root:
+                if (ch != '[' && ch != '{')
+                    throw invalid_json_exception(std::format(
+                        "expected array or object declaration as json root, "
+                        "but got `{}`",
+                        ch));
+
+                return _read_value(ch);
+
+            case state::FirstItem:
+                if (ch == ']') return _close(ch);
+                [[fallthrough]];
+
+            case state::Item:
+                if (_idx == _source.size()) _throw_unclosed();
+                if (ch == ',')
+                    throw invalid_json_exception(std::format(
+                        "item separator found with no previous item "
+                        "declared at position {}",
+                        position()));
+
+                return _read_value(ch);
+
+            case state::AfterItem: {
+                if (_idx == _source.size()) _throw_unclosed();
+                if (ch == ']' || ch == '}') return _close(ch);
+
+                const auto isArray{_scopes.back().bracket == '['};
+                if (ch != ',')
+                    throw invalid_json_exception(std::format(
+                        "expected item separator `,` or `{}`, but got `{}` at "
+                        "position {}",
+                        isArray ? ']' : '}', ch, position()));
+
+                _idx++;
+                _state = isArray ? state::Item : state::Key;
+                continue;
+            }
+
+            case state::FirstKey:
+                if (ch == '}') return _close(ch);
+                if (ch == ',')
+                    throw invalid_json_exception(std::format(
+                        "item separator found with no previous item "
+                        "declared at position {}",
+                        position()));
+                [[fallthrough]];
+
+            case state::Key: {
+                if (_idx == _source.size()) _throw_unclosed();
+                if (ch != '"')
+                    throw invalid_json_exception(
+                        std::format("expected open quote for object key "
+                                    "declaration, but got `{}` at position {}",
+                                    ch, position()));
+
+                _read_string();
+                if (_string.empty())
+                    throw invalid_json_exception(std::format(
+                        "missing or empty object key at position {}",
+                        position()));
+
+                _state = state::Colon;
+                return event_tag::ObjectKey;
+            }
+
+            case state::Colon:
+                if (ch != ':')
+                    throw invalid_json_exception(std::format(
+                        "expected field initialiser operator `:`, but got "
+                        "`{}` at position {}",
+                        ch, position()));
+
+                _idx++;
+                _state = state::Item;
+                continue;
+
+            case state::Done:
+                if (_idx < _source.size())
+                    throw invalid_json_exception(std::format(
+                        "unexpected content after json root at position {}",
+                        position()));
+
+                return event_tag::DocumentEnd;
+        }
+    }
+}
+
+auto reader::feed(std::string_view chunk) -> void {
+    _buffer.erase(0, _idx);
+    _offset += _idx;
+    _idx = 0;
+
+    _buffer.append(chunk);
+    _source = _buffer;
+}
+
+auto reader::finish() noexcept -> void {
+    _final = true;
+}
+
+auto reader::boolean() const noexcept -> bool {
+    return _boolean;
+}
+
+auto reader::number() const noexcept -> number_t {
+    return _number;
+}
+
+auto reader::out_of_range() const noexcept -> bool {
+    return _outOfRange;
+}
+
+auto reader::string() const noexcept -> std::string_view {
+    return _string;
+}
+
+auto reader::escaped() const noexcept -> bool {
+    return _escaped;
+}
+
+auto reader::position() const noexcept -> std::size_t {
+    return _offset + _position;
+}
+
+auto reader::depth() const noexcept -> std::size_t {
+    return _scopes.size();
+}
+
+auto reader::_skip_whitespace() noexcept -> char {
+    if (_indexed) {
+        const std::size_t next{_next < _index.size() ? _index[_next]
+                                                     : _source.size()};
+        // bytes glued to the previous scalar are not in the index
+        if (_idx < next && !is_whitespace(_source[_idx])) return _source[_idx];
+
+        _idx = next;
+        _next++;
+    }
+
+    while (_idx < _source.size() && is_whitespace(_source[_idx])) _idx++;
+    return _idx < _source.size() ? _source[_idx] : '\0';
+}
+
+auto reader::_token_complete() const noexcept -> bool {
+    if (_final) return true;
+    if (_idx == _source.size()) return false;
+
+    switch (_source[_idx]) {
+        case '[':
+        case ']':
+        case '{':
+        case '}':
+        case ',':
+        case ':':
+            return true;
+
+        case '"':
+            for (auto idx{_idx + 1}; idx < _source.size(); idx++) {
+                if (_source[idx] == '\\')
+                    idx++;
+                else if (_source[idx] == '"')
+                    return true;
+            }
+            return false;
+    }
+
+    // numbers and literals end on the first byte that cannot continue them
+    for (auto idx{_idx}; idx < _source.size(); idx++) {
+        const auto ch{_source[idx]};
+        if (!isalnum(ch) && ch != '-' && ch != '+' && ch != '.') return true;
+    }
+    return false;
+}
+
+auto reader::_read_string() -> void {
+    const auto startPosition{_offset + _idx + 1};
+    const auto raw{scan_string(_source, _idx)};
+    _string = decode_string(raw, _decoded, startPosition);
+    _escaped = _string.data() != raw.data();
+}
+
+auto reader::_read_value(char ch) -> event_tag {
+    switch (ch) {
+        case '[':
+        case '{':
+            _scopes.push_back({ch, _offset + _idx++});
+            _state = ch == '[' ? state::FirstItem : state::FirstKey;
+            return ch == '[' ? event_tag::ArrayStart : event_tag::ObjectStart;
+
+        case '"':
+            _read_string();
+            _state = state::AfterItem;
+            return event_tag::JsonString;
+
+        case ',':
+        case ']':
+        case '}':
+            throw invalid_json_exception(std::format(
+                "missing or empty object field value at position {}",
+                position()));
+    }
+
+    _state = state::AfterItem;
+    if (ch == '-' || isdigit(ch)) {
+        const auto startIdx{_idx};
+        _number = scan_number(_source, _idx, _outOfRange);
+        _string = _source.substr(startIdx, _idx - startIdx);
+        return event_tag::JsonNumber;
+    }
+
+    const auto literal{scan_literal(_source, _idx)};
+    if (literal == "null") return event_tag::JsonNull;
+    if (literal == "true" || literal == "false") {
+        _boolean = literal == "true";
+        return event_tag::JsonBool;
+    }
+
+    throw invalid_json_exception(
+        std::format("cannot parse object field value `{}` at position {}",
+                    literal.empty() ? std::string_view{&ch, 1} : literal,
+                    position()));
+}
+
+auto reader::_close(char ch) -> event_tag {
+    const auto isArray{_scopes.back().bracket == '['};
+    if ((ch == ']') != isArray)
+        throw invalid_json_exception(std::format(
+            "expected item separator `,` or `{}`, but got `{}` at position {}",
+            isArray ? ']' : '}', ch, position()));
+
+    _idx++;
+    _scopes.pop_back();
+    _state = _scopes.empty() ? state::Done : state::AfterItem;
+    return isArray ? event_tag::ArrayEnd : event_tag::ObjectEnd;
+}
+
+auto reader::_throw_unclosed() const -> void {
+    const auto& scope{_scopes.back()};
+    throw invalid_json_exception(
+        std::format("unclosed {} found, opened at position {}",
+                    scope.bracket == '[' ? "array" : "object", scope.position));
+}
+}  // namespace json
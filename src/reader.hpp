@@ -0,0 +1,159 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "lexer.hpp"
+
+namespace json {
+enum class event_tag : uint {
+    JsonNull,
+    JsonBool,
+    JsonNumber,
+    JsonString,
+    ArrayStart,
+    ArrayEnd,
+    ObjectStart,
+    ObjectKey,
+    ObjectEnd,
+    DocumentEnd,
+    // only produced by streaming readers, which need another chunk
+    NeedInput
+};
+
+// pull tokenizer shared by every front end of the library, it walks the
+// document without recursion so its memory is bounded by the nesting depth
+class reader final {
+   public:
+    // streaming reader, the document is handed over chunk by chunk
+    reader() noexcept;
+    explicit reader(std::string_view source) noexcept;
+    // jumps between the positions of a structural index built over `source`
+    reader(std::string_view source,
+           std::span<const std::uint32_t> index) noexcept;
+
+    // starts over on a complete document, keeping the allocated scopes
+    auto reset(std::string_view source) noexcept -> void;
+    auto reset(std::string_view source,
+               std::span<const std::uint32_t> index) noexcept -> void;
+
+    [[nodiscard]] auto next() -> event_tag;
+
+    // the unfinished token of the previous chunk is kept, string values of
+    // earlier events are invalidated
+    auto feed(std::string_view chunk) -> void;
+    auto finish() noexcept -> void;
+
+    template <std::invocable<event_tag, const reader&> Handler>
+    auto feed(std::string_view chunk, Handler&& handler) -> void {
+        feed(chunk);
+        _dispatch(handler);
+    }
+
+    template <std::invocable<event_tag, const reader&> Handler>
+    auto finish(Handler&& handler) -> void {
+        finish();
+        _dispatch(handler);
+    }
+
+    // values of the last event, `string` also holds the lexeme of numbers
+    [[nodiscard]] auto boolean() const noexcept -> bool;
+    [[nodiscard]] auto number() const noexcept -> number_t;
+    // the last number did not fit a double, `number` holds it rounded to
+    // zero or infinity and `string` its lexeme
+    [[nodiscard]] auto out_of_range() const noexcept -> bool;
+    [[nodiscard]] auto string() const noexcept -> std::string_view;
+    // the last string held escapes, it was decoded into a buffer of the
+    // reader and is only valid until the next event instead of borrowing
+    // from the source
+    [[nodiscard]] auto escaped() const noexcept -> bool;
+
+    [[nodiscard]] auto position() const noexcept -> std::size_t;
+    [[nodiscard]] auto depth() const noexcept -> std::size_t;
+
+   private:
+    enum class state : uint {
+        Root,
+        FirstItem,
+        Item,
+        AfterItem,
+        FirstKey,
+        Key,
+        Colon,
+        Done
+    };
+
+    struct scope {
+        char bracket;
+        std::size_t position;
+    };
+
+    template <class Handler>
+    auto _dispatch(Handler& handler) -> void {
+        for (auto event{next()}; event != event_tag::NeedInput;
+             event = next()) {
+            handler(event, std::as_const(*this));
+            if (event == event_tag::DocumentEnd) break;
+        }
+    }
+
+    auto _skip_whitespace() noexcept -> char;
+    auto _token_complete() const noexcept -> bool;
+    auto _read_value(char ch) -> event_tag;
+    auto _read_string() -> void;
+    auto _close(char ch) -> event_tag;
+    [[noreturn]] auto _throw_unclosed() const -> void;
+
+   private:
+    std::string_view _source;
+    std::size_t _idx{0};
+    std::size_t _position{0};
+    std::span<const std::uint32_t> _index{};
+    std::size_t _next{0};
+    bool _indexed{false};
+    state _state{state::Root};
+    std::vector<scope> _scopes{};
+
+    // streaming readers only
+    std::string _buffer{};
+    std::size_t _offset{0};
+    bool _final{true};
+
+    bool _boolean{false};
+    number_t _number{};
+    bool _outOfRange{false};
+    std::string_view _string{};
+    std::string _decoded{};
+    bool _escaped{false};
+};
+
+// streams a file of any size through `handler` in fixed size chunks
+template <std::invocable<event_tag, const reader&> Handler>
+auto read_file_events(const char* filepath, Handler&& handler,
+                      std::size_t chunkSize = 1 << 20) -> void {
+    const auto file{std::fopen(filepath, "rb")};
+    if (!file)
+        throw invalid_json_exception(
+            std::format("cannot open file `{}`", filepath));
+
+    try {
+        reader reader{};
+        std::string chunk(chunkSize, '\0');
+        while (const auto size = std::fread(chunk.data(), 1, chunk.size(), file))
+            reader.feed({chunk.data(), size}, handler);
+
+        reader.finish(handler);
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    std::fclose(file);
+}
+}  // namespace json
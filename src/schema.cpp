@@ -0,0 +1,648 @@
+#include "schema.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <utility>
+#include <variant>
+
+#include "path.hpp"
+#include "serializer.hpp"
+
+namespace json {
+constexpr uint typeNull{1 << 0};
+constexpr uint typeBoolean{1 << 1};
+constexpr uint typeInteger{1 << 2};
+constexpr uint typeNumber{1 << 3};
+constexpr uint typeString{1 << 4};
+constexpr uint typeArray{1 << 5};
+constexpr uint typeObject{1 << 6};
+
+// integers are numbers too, and floats without a fractional part integers
+auto type_of(const node& value) -> uint {
+    switch (value.tag()) {
+        case node_tag::JsonNull:
+            return typeNull;
+        case node_tag::JsonBool:
+            return typeBoolean;
+        case node_tag::JsonInt:
+            return typeInteger | typeNumber;
+        case node_tag::JsonFloat: {
+            const auto number{value.value<double>()};
+            return std::isfinite(number) && std::trunc(number) == number
+                       ? typeInteger | typeNumber
+                       : typeNumber;
+        }
+        case node_tag::JsonString:
+            return typeString;
+        case node_tag::JsonArray:
+            return typeArray;
+        case node_tag::JsonObject:
+            return typeObject;
+    }
+    return 0;
+}
+
+auto type_name(const node& value) noexcept -> std::string_view {
+    constexpr std::string_view names[]{"null",   "boolean", "integer",
+                                       "number", "string",  "array",
+                                       "object"};
+    return names[static_cast<std::size_t>(value.tag())];
+}
+
+auto parse_type(std::string_view name) -> uint {
+    if (name == "null") return typeNull;
+    if (name == "boolean") return typeBoolean;
+    if (name == "integer") return typeInteger;
+    if (name == "number") return typeInteger | typeNumber;
+    if (name == "string") return typeString;
+    if (name == "array") return typeArray;
+    if (name == "object") return typeObject;
+    throw invalid_schema_exception(std::format("unknown type `{}`", name));
+}
+
+auto integer_of(const node& value)
+    -> std::optional<std::variant<std::int64_t, std::uint64_t>> {
+    if (const auto integer = value.get_if<std::int64_t>()) return *integer;
+    if (const auto integer = value.get_if<std::uint64_t>()) return *integer;
+    return std::nullopt;
+}
+
+// integers are compared exactly, as doubles only against floats
+auto compare(const node& lhs, const node& rhs) -> std::partial_ordering {
+    const auto lhsInt{integer_of(lhs)};
+    const auto rhsInt{integer_of(rhs)};
+    if (!lhsInt || !rhsInt) return lhs.value<double>() <=> rhs.value<double>();
+
+    return std::visit(
+        [](auto lhs, auto rhs) -> std::partial_ordering {
+            if (std::cmp_less(lhs, rhs)) return std::partial_ordering::less;
+            if (std::cmp_greater(lhs, rhs))
+                return std::partial_ordering::greater;
+            return std::partial_ordering::equivalent;
+        },
+        *lhsInt, *rhsInt);
+}
+
+// numbers are compared by value, 1 and 1.0 are equal
+auto equal(const node& lhs, const node& rhs) -> bool {
+    if ((type_of(lhs) & typeNumber) && (type_of(rhs) & typeNumber))
+        return compare(lhs, rhs) == 0;
+    if (lhs.tag() != rhs.tag()) return false;
+
+    switch (lhs.tag()) {
+        case node_tag::JsonBool:
+            return lhs.value<bool>() == rhs.value<bool>();
+        case node_tag::JsonString:
+            return lhs.string() == rhs.string();
+        case node_tag::JsonArray:
+            return std::ranges::equal(lhs.items(), rhs.items(), equal);
+        case node_tag::JsonObject:
+            return lhs.fields().size() == rhs.fields().size() &&
+                   std::ranges::all_of(lhs.fields(), [&](const auto& entry) {
+                       const auto it{rhs.fields().find(entry.first.view())};
+                       return it != rhs.fields().end() &&
+                              equal(entry.second, it->second);
+                   });
+        default:
+            return true;
+    }
+}
+
+// borrowed strings of the schema document are copied
+auto owned(const node& value) -> node {
+    switch (value.tag()) {
+        case node_tag::JsonString:
+            return node{std::string{value.string()}};
+        case node_tag::JsonArray: {
+            array retval{};
+            for (const auto& item : value.items())
+                retval.push_back(owned(item));
+            return node{std::move(retval)};
+        }
+        case node_tag::JsonObject: {
+            object retval{};
+            for (const auto& [key, field] : value.fields())
+                retval.emplace(key.view(), owned(field));
+            return node{std::move(retval)};
+        }
+        default:
+            return value;
+    }
+}
+
+auto number_of(const node& value, std::string_view keyword) -> node {
+    if (value.tag() != node_tag::JsonInt && value.tag() != node_tag::JsonFloat)
+        throw invalid_schema_exception(
+            std::format("`{}` must be a number", keyword));
+    return owned(value);
+}
+
+auto count_of(const node& value, std::string_view keyword) -> std::size_t {
+    if (value.tag() != node_tag::JsonInt || value.value<double>() < 0)
+        throw invalid_schema_exception(
+            std::format("`{}` must be a non-negative integer", keyword));
+    return value.value<std::size_t>();
+}
+
+auto items_of(const node& value, std::string_view keyword) -> const array& {
+    if (value.tag() != node_tag::JsonArray || value.items().empty())
+        throw invalid_schema_exception(
+            std::format("`{}` must be a non-empty array", keyword));
+    return value.items();
+}
+
+// length in code points, the input is valid utf-8
+auto length_of(std::string_view value) noexcept -> std::size_t {
+    return static_cast<std::size_t>(std::ranges::count_if(
+        value, [](char ch) { return (ch & 0xC0) != 0x80; }));
+}
+
+// json pointer token
+auto append_key(std::string& path, std::string_view key) -> void {
+    path += '/';
+    for (const auto ch : key) {
+        if (ch == '~')
+            path += "~0";
+        else if (ch == '/')
+            path += "~1";
+        else
+            path += ch;
+    }
+}
+
+auto violation(const std::string& path, std::string message)
+    -> std::optional<schema_error> {
+    return schema_error{path, std::move(message)};
+}
+
+/* schema implementation */
+auto schema::compile(const node& document) -> schema {
+    schema retval{};
+    std::unordered_map<const node*, std::uint32_t> ids{};
+    retval._compile(document, document, ids);
+    retval._reject_cycles();
+    return retval;
+}
+
+auto schema::validate(const node& value) const -> std::optional<schema_error> {
+    if (_rules.empty()) return std::nullopt;
+
+    std::string path{};
+    return _check(0, value, path);
+}
+
+// rules are registered before their subschemas are compiled, so references
+// may be recursive
+auto schema::_compile(const node& document, const node& value,
+                      std::unordered_map<const node*, std::uint32_t>& ids)
+    -> std::uint32_t {
+    if (const auto it = ids.find(&value); it != ids.end()) return it->second;
+
+    const auto id{static_cast<std::uint32_t>(_rules.size())};
+    ids.emplace(&value, id);
+    _rules.emplace_back();
+
+    rule retval{};
+    if (value.tag() == node_tag::JsonBool) {
+        if (!value.value<bool>()) retval.types = 0;
+        _rules[id] = std::move(retval);
+        return id;
+    }
+    if (value.tag() != node_tag::JsonObject)
+        throw invalid_schema_exception(
+            "a schema must be an object or a boolean");
+
+    const auto subschemas{[&](const node& field, std::string_view keyword) {
+        std::vector<std::uint32_t> compiled{};
+        for (const auto& item : items_of(field, keyword))
+            compiled.push_back(_compile(document, item, ids));
+        return compiled;
+    }};
+
+    for (const auto& [key, field] : value.fields()) {
+        const auto keyword{key.view()};
+        if (keyword == "type") {
+            if (field.tag() == node_tag::JsonString) {
+                retval.types = parse_type(field.string());
+            } else {
+                retval.types = 0;
+                for (const auto& item : items_of(field, keyword)) {
+                    if (item.tag() != node_tag::JsonString)
+                        throw invalid_schema_exception(
+                            "`type` must hold type names");
+                    retval.types |= parse_type(item.string());
+                }
+            }
+        } else if (keyword == "enum") {
+            for (const auto& item : items_of(field, keyword))
+                retval.allowed.push_back(owned(item));
+            retval.enumerated = true;
+        } else if (keyword == "const") {
+            retval.allowed = {owned(field)};
+            retval.enumerated = true;
+        } else if (keyword == "minimum") {
+            retval.minimum = number_of(field, keyword);
+        } else if (keyword == "maximum") {
+            retval.maximum = number_of(field, keyword);
+        } else if (keyword == "exclusiveMinimum") {
+            retval.exclusiveMinimum = number_of(field, keyword);
+        } else if (keyword == "exclusiveMaximum") {
+            retval.exclusiveMaximum = number_of(field, keyword);
+        } else if (keyword == "minLength") {
+            retval.minLength = count_of(field, keyword);
+        } else if (keyword == "maxLength") {
+            retval.maxLength = count_of(field, keyword);
+        } else if (keyword == "minItems") {
+            retval.minItems = count_of(field, keyword);
+        } else if (keyword == "maxItems") {
+            retval.maxItems = count_of(field, keyword);
+        } else if (keyword == "minProperties") {
+            retval.minProperties = count_of(field, keyword);
+        } else if (keyword == "maxProperties") {
+            retval.maxProperties = count_of(field, keyword);
+        } else if (keyword == "pattern") {
+            throw invalid_schema_exception(
+                "`pattern` is not supported, regular expressions are not "
+                "checked in linear time");
+        } else if (keyword == "items") {
+            if (field.tag() == node_tag::JsonArray)
+                throw invalid_schema_exception(
+                    "`items` arrays are not supported, use a single schema");
+            retval.items = _compile(document, field, ids);
+        } else if (keyword == "properties") {
+            if (field.tag() != node_tag::JsonObject)
+                throw invalid_schema_exception(
+                    "`properties` must be an object");
+            for (const auto& [name, property] : field.fields())
+                retval.properties.emplace_back(
+                    std::string{name.view()},
+                    _compile(document, property, ids));
+            std::ranges::sort(retval.properties);
+        } else if (keyword == "required") {
+            if (field.tag() != node_tag::JsonArray)
+                throw invalid_schema_exception("`required` must be an array");
+            for (const auto& item : field.items()) {
+                if (item.tag() != node_tag::JsonString)
+                    throw invalid_schema_exception(
+                        "`required` must hold key names");
+                retval.required.emplace_back(item.string());
+            }
+        } else if (keyword == "additionalProperties") {
+            retval.additional = _compile(document, field, ids);
+        } else if (keyword == "allOf") {
+            std::ranges::copy(subschemas(field, keyword),
+                              std::back_inserter(retval.all));
+        } else if (keyword == "anyOf") {
+            retval.any = subschemas(field, keyword);
+        } else if (keyword == "oneOf") {
+            retval.one = subschemas(field, keyword);
+        } else if (keyword == "not") {
+            retval.negated = _compile(document, field, ids);
+        } else if (keyword == "$ref") {
+            if (field.tag() != node_tag::JsonString ||
+                !field.string().starts_with('#'))
+                throw invalid_schema_exception(
+                    "only local `$ref` like `#/$defs/name` are supported");
+            const auto target{
+                path::pointer(field.string().substr(1)).find(document)};
+            if (!target)
+                throw invalid_schema_exception(std::format(
+                    "unresolved reference `{}`", field.string()));
+            retval.all.push_back(_compile(document, *target, ids));
+        } else if (keyword != "$schema" && keyword != "$id" &&
+                   keyword != "$comment" && keyword != "$defs" &&
+                   keyword != "definitions" && keyword != "title" &&
+                   keyword != "description" && keyword != "default" &&
+                   keyword != "examples" && keyword != "format" &&
+                   keyword != "deprecated" && keyword != "readOnly" &&
+                   keyword != "writeOnly") {
+            throw invalid_schema_exception(
+                std::format("unsupported schema keyword `{}`", keyword));
+        }
+    }
+
+    retval.needsValue =
+        !retval.any.empty() || !retval.one.empty() || retval.negated;
+    _rules[id] = std::move(retval);
+    return id;
+}
+
+auto schema::_reject_cycles() const -> void {
+    enum class mark : char { New, Open, Done };
+    std::vector<mark> marks(_rules.size(), mark::New);
+
+    const auto visit{[&](const auto& self, std::uint32_t rule) -> void {
+        if (marks[rule] == mark::Done) return;
+        if (marks[rule] == mark::Open)
+            throw invalid_schema_exception(
+                "subschemas reference each other in a cycle without "
+                "descending into items or fields");
+
+        marks[rule] = mark::Open;
+        const auto& current{_rules[rule]};
+        for (const auto other : current.all) self(self, other);
+        for (const auto other : current.any) self(self, other);
+        for (const auto other : current.one) self(self, other);
+        if (current.negated) self(self, *current.negated);
+        marks[rule] = mark::Done;
+    }};
+    for (std::uint32_t rule{0}; rule < _rules.size(); rule++)
+        visit(visit, rule);
+}
+
+auto schema::_field(std::uint32_t rule, std::string_view key) const
+    -> std::optional<std::uint32_t> {
+    const auto& properties{_rules[rule].properties};
+    const auto it{std::ranges::lower_bound(
+        properties, key, {}, [](const auto& entry) -> std::string_view {
+            return entry.first;
+        })};
+    if (it != properties.end() && it->first == key) return it->second;
+    return _rules[rule].additional;
+}
+
+auto schema::_expand(std::uint32_t rule, std::vector<std::uint32_t>& out,
+                     std::size_t begin) const -> void {
+    if (std::find(out.begin() + begin, out.end(), rule) != out.end()) return;
+
+    out.push_back(rule);
+    for (const auto other : _rules[rule].all) _expand(other, out, begin);
+}
+
+auto schema::_check(std::uint32_t rule, const node& value,
+                    std::string& path) const -> std::optional<schema_error> {
+    if (auto error = _check_value(rule, value, path)) return error;
+
+    const auto& current{_rules[rule]};
+    for (const auto other : current.all)
+        if (auto error = _check(other, value, path)) return error;
+
+    const auto matches{[&](std::uint32_t other) {
+        return !_check(other, value, path).has_value();
+    }};
+    if (!current.any.empty() && std::ranges::none_of(current.any, matches))
+        return violation(path, "value matches none of the anyOf schemas");
+    if (!current.one.empty()) {
+        if (const auto count = std::ranges::count_if(current.one, matches);
+            count != 1)
+            return violation(
+                path, std::format("value matches {} of the oneOf schemas "
+                                  "instead of one",
+                                  count));
+    }
+    if (current.negated && matches(*current.negated))
+        return violation(path, "value matches a schema it must not");
+
+    const auto pathSize{path.size()};
+    if (value.tag() == node_tag::JsonArray) {
+        const auto& items{value.items()};
+        if (auto error = _check_size(rule, value.tag(), items.size(), path))
+            return error;
+        if (!current.items) return std::nullopt;
+
+        for (std::size_t idx{0}; idx < items.size(); idx++) {
+            path += std::format("/{}", idx);
+            auto error{_check(*current.items, items[idx], path)};
+            path.resize(pathSize);
+            if (error) return error;
+        }
+    } else if (value.tag() == node_tag::JsonObject) {
+        const auto& fields{value.fields()};
+        if (auto error = _check_size(rule, value.tag(), fields.size(), path))
+            return error;
+        for (const auto& key : current.required)
+            if (!fields.contains(key))
+                return violation(path,
+                                 std::format("missing required key `{}`", key));
+
+        for (const auto& [key, field] : fields) {
+            const auto other{_field(rule, key.view())};
+            if (!other) continue;
+
+            append_key(path, key.view());
+            auto error{_check(*other, field, path)};
+            path.resize(pathSize);
+            if (error) return error;
+        }
+    }
+    return std::nullopt;
+}
+
+auto schema::_check_value(std::uint32_t rule, const node& value,
+                          const std::string& path) const
+    -> std::optional<schema_error> {
+    const auto& current{_rules[rule]};
+    if (!(type_of(value) & current.types))
+        return violation(path, current.types == 0
+                                   ? "no value is allowed here"
+                                   : std::format("unexpected {} value",
+                                                 type_name(value)));
+
+    if (current.enumerated &&
+        std::ranges::none_of(current.allowed, [&](const node& allowed) {
+            return equal(allowed, value);
+        }))
+        return violation(path, "value is not one of the allowed values");
+
+    if (type_of(value) & typeNumber) {
+        if (current.minimum && compare(value, *current.minimum) < 0)
+            return violation(path, std::format("{} is below the minimum {}",
+                                               serialize(value),
+                                               serialize(*current.minimum)));
+        if (current.exclusiveMinimum &&
+            compare(value, *current.exclusiveMinimum) <= 0)
+            return violation(path,
+                             std::format("{} is not above {}", serialize(value),
+                                         serialize(*current.exclusiveMinimum)));
+        if (current.maximum && compare(value, *current.maximum) > 0)
+            return violation(path, std::format("{} is above the maximum {}",
+                                               serialize(value),
+                                               serialize(*current.maximum)));
+        if (current.exclusiveMaximum &&
+            compare(value, *current.exclusiveMaximum) >= 0)
+            return violation(path,
+                             std::format("{} is not below {}", serialize(value),
+                                         serialize(*current.exclusiveMaximum)));
+    } else if (value.tag() == node_tag::JsonString &&
+               (current.minLength || current.maxLength)) {
+        const auto length{length_of(value.string())};
+        if (current.minLength && length < *current.minLength)
+            return violation(path,
+                             std::format("string is shorter than {} characters",
+                                         *current.minLength));
+        if (current.maxLength && length > *current.maxLength)
+            return violation(path,
+                             std::format("string is longer than {} characters",
+                                         *current.maxLength));
+    }
+    return std::nullopt;
+}
+
+auto schema::_check_size(std::uint32_t rule, node_tag tag, std::size_t size,
+                         const std::string& path) const
+    -> std::optional<schema_error> {
+    const auto& current{_rules[rule]};
+    if (tag == node_tag::JsonArray) {
+        if (current.minItems && size < *current.minItems)
+            return violation(path, std::format("array has fewer than {} items",
+                                               *current.minItems));
+        if (current.maxItems && size > *current.maxItems)
+            return violation(path, std::format("array has more than {} items",
+                                               *current.maxItems));
+    } else {
+        if (current.minProperties && size < *current.minProperties)
+            return violation(path,
+                             std::format("object has fewer than {} fields",
+                                         *current.minProperties));
+        if (current.maxProperties && size > *current.maxProperties)
+            return violation(path, std::format("object has more than {} fields",
+                                               *current.maxProperties));
+    }
+    return std::nullopt;
+}
+
+/* schema_checker implementation */
+schema_checker::schema_checker(const schema& schema) : _schema(&schema) {}
+
+auto schema_checker::operator()(event_tag event, const reader& reader)
+    -> void {
+    if (_building) {
+        if (!_builder.push(event, reader)) return;
+
+        _building = false;
+        const auto value{_builder.take()};
+        for (auto idx{_buildingRules}; idx < _rules.size(); idx++)
+            _throw_if(_schema->_check(_rules[idx], value, _path));
+        _end_value(_buildingRules, _buildingPath);
+        return;
+    }
+
+    switch (event) {
+        case event_tag::ObjectKey:
+            _key.assign(reader.string());
+            return;
+
+        case event_tag::ArrayEnd:
+        case event_tag::ObjectEnd:
+            _end_container();
+            return;
+
+        case event_tag::DocumentEnd:
+        case event_tag::NeedInput:
+            return;
+
+        default:
+            _value(event, reader);
+    }
+}
+
+auto schema_checker::reset() noexcept -> void {
+    _rules.clear();
+    _frames.clear();
+    _seen.clear();
+    _path.clear();
+    _builder.reset();
+    _building = false;
+}
+
+// the rules of a value are derived from the rules of its container
+auto schema_checker::_value(event_tag event, const reader& reader) -> void {
+    const auto rulesBegin{_rules.size()};
+    const auto pathSize{_path.size()};
+    if (_frames.empty()) {
+        if (!_schema->_rules.empty()) _schema->_expand(0, _rules, rulesBegin);
+    } else if (const auto& top = _frames.back(); top.isObject) {
+        append_key(_path, _key);
+        auto seen{top.seenBegin};
+        for (auto idx{top.rulesBegin}; idx < top.rulesEnd; idx++) {
+            const auto& required{_schema->_rules[_rules[idx]].required};
+            for (std::size_t key{0}; key < required.size(); key++)
+                if (required[key] == _key) _seen[seen + key] = true;
+            seen += required.size();
+
+            if (const auto field = _schema->_field(_rules[idx], _key))
+                _schema->_expand(*field, _rules, rulesBegin);
+        }
+    } else {
+        _path += std::format("/{}", top.count);
+        for (auto idx{top.rulesBegin}; idx < top.rulesEnd; idx++)
+            if (const auto items = _schema->_rules[_rules[idx]].items)
+                _schema->_expand(*items, _rules, rulesBegin);
+    }
+
+    const bool isObject{event == event_tag::ObjectStart};
+    if (!isObject && event != event_tag::ArrayStart) {
+        node value{};
+        if (event == event_tag::JsonBool)
+            value = node{reader.boolean()};
+        else if (event == event_tag::JsonNumber)
+            value = std::visit([](auto number) { return node{number}; },
+                               reader.number());
+        else if (event == event_tag::JsonString)
+            value = node{reader.string()};
+
+        for (auto idx{rulesBegin}; idx < _rules.size(); idx++)
+            _throw_if(_schema->_check(_rules[idx], value, _path));
+        _end_value(rulesBegin, pathSize);
+        return;
+    }
+
+    if (std::any_of(_rules.begin() + rulesBegin, _rules.end(), [&](auto rule) {
+            const auto& current{_schema->_rules[rule]};
+            return current.needsValue || current.enumerated;
+        })) {
+        _builder.reset();
+        _builder.push(event, reader);
+        _building = true;
+        _buildingRules = rulesBegin;
+        _buildingPath = pathSize;
+        return;
+    }
+
+    const node empty{isObject ? node{object{}} : node{array{}}};
+    std::size_t required{0};
+    for (auto idx{rulesBegin}; idx < _rules.size(); idx++) {
+        _throw_if(_schema->_check_value(_rules[idx], empty, _path));
+        required += _schema->_rules[_rules[idx]].required.size();
+    }
+
+    _frames.push_back(
+        {isObject, rulesBegin, _rules.size(), pathSize, 0, _seen.size()});
+    _seen.resize(_seen.size() + required, false);
+}
+
+auto schema_checker::_end_container() -> void {
+    const auto top{_frames.back()};
+    const auto tag{top.isObject ? node_tag::JsonObject : node_tag::JsonArray};
+
+    auto seen{top.seenBegin};
+    for (auto idx{top.rulesBegin}; idx < top.rulesEnd; idx++) {
+        _throw_if(_schema->_check_size(_rules[idx], tag, top.count, _path));
+
+        const auto& required{_schema->_rules[_rules[idx]].required};
+        for (std::size_t key{0}; key < required.size(); key++)
+            if (!_seen[seen + key])
+                _throw_if(violation(
+                    _path,
+                    std::format("missing required key `{}`", required[key])));
+        seen += required.size();
+    }
+
+    _frames.pop_back();
+    _seen.resize(top.seenBegin);
+    _end_value(top.rulesBegin, top.pathSize);
+}
+
+auto schema_checker::_end_value(std::size_t rulesBegin, std::size_t pathSize)
+    -> void {
+    _rules.resize(rulesBegin);
+    _path.resize(pathSize);
+    if (!_frames.empty()) _frames.back().count++;
+}
+
+auto schema_checker::_throw_if(std::optional<schema_error>&& error) const
+    -> void {
+    if (error) throw schema_violation_exception(std::move(*error));
+}
+}  // namespace json
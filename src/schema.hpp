@@ -0,0 +1,177 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "json.hpp"
+#include "parser.hpp"
+#include "reader.hpp"
+
+namespace json {
+class invalid_schema_exception final : public std::exception {
+   public:
+    invalid_schema_exception(const std::string& msg) : _msg(msg) {}
+    auto what() const noexcept -> const char* {
+        return _msg.c_str();
+    }
+
+   private:
+    const std::string _msg{};
+};
+
+struct schema_error {
+    // json pointer to the offending value, "" for the root
+    std::string path{};
+    std::string message{};
+};
+
+class schema_violation_exception final : public std::exception {
+   public:
+    schema_violation_exception(schema_error error)
+        : _error(std::move(error)),
+          _msg(std::format("schema violation at `{}`: {}", _error.path,
+                           _error.message)) {}
+    auto what() const noexcept -> const char* {
+        return _msg.c_str();
+    }
+    [[nodiscard]] auto error() const noexcept -> const schema_error& {
+        return _error;
+    }
+
+   private:
+    const schema_error _error{};
+    const std::string _msg{};
+};
+
+// json schema compiled once into a flat list of rules, where subschemas
+// refer to each other by index; supported keywords are type, enum, const,
+// the numeric, length and size bounds, items, properties, required,
+// additionalProperties, allOf, anyOf, oneOf, not and local $ref, any other
+// assertion is rejected instead of being silently ignored; `pattern` is
+// rejected too, a backtracking regex would make checks while parsing
+// unbounded on long strings
+class schema final {
+   public:
+    schema() noexcept = default;
+
+    // the document can be dropped once compiled
+    [[nodiscard]] static auto compile(const node& document) -> schema;
+
+    // first violation in document order, std::nullopt for valid values
+    [[nodiscard]] auto validate(const node& value) const
+        -> std::optional<schema_error>;
+
+   private:
+    friend class schema_checker;
+
+    struct rule {
+        // one bit per type, a false schema allows none
+        uint types{0x7F};
+        std::vector<node> allowed{};
+        bool enumerated{false};
+        // kept as nodes, integers are compared exactly
+        std::optional<node> minimum{};
+        std::optional<node> maximum{};
+        std::optional<node> exclusiveMinimum{};
+        std::optional<node> exclusiveMaximum{};
+        std::optional<std::size_t> minLength{};
+        std::optional<std::size_t> maxLength{};
+        std::optional<std::size_t> minItems{};
+        std::optional<std::size_t> maxItems{};
+        std::optional<std::size_t> minProperties{};
+        std::optional<std::size_t> maxProperties{};
+        // sorted by key
+        std::vector<std::pair<std::string, std::uint32_t>> properties{};
+        std::vector<std::string> required{};
+        std::optional<std::uint32_t> additional{};
+        std::optional<std::uint32_t> items{};
+        // $ref is applied like one more allOf schema
+        std::vector<std::uint32_t> all{};
+        std::vector<std::uint32_t> any{};
+        std::vector<std::uint32_t> one{};
+        std::optional<std::uint32_t> negated{};
+        // anyOf, oneOf and not need the whole value, like enums of
+        // containers; streamed values are built before they are checked
+        bool needsValue{false};
+    };
+
+    auto _compile(const node& document, const node& value,
+                  std::unordered_map<const node*, std::uint32_t>& ids)
+        -> std::uint32_t;
+    // subschemas applied to the same value must not lead back to the rule
+    // they start from, recursion has to go through items or fields
+    auto _reject_cycles() const -> void;
+
+    // the subschema of a field, if any
+    [[nodiscard]] auto _field(std::uint32_t rule, std::string_view key) const
+        -> std::optional<std::uint32_t>;
+    // appends the rule and its allOf schemas unless they already are in
+    // `out` past `begin`
+    auto _expand(std::uint32_t rule, std::vector<std::uint32_t>& out,
+                 std::size_t begin) const -> void;
+
+    [[nodiscard]] auto _check(std::uint32_t rule, const node& value,
+                              std::string& path) const
+        -> std::optional<schema_error>;
+    // the assertions on the value itself, not on its items or fields
+    [[nodiscard]] auto _check_value(std::uint32_t rule, const node& value,
+                                    const std::string& path) const
+        -> std::optional<schema_error>;
+    [[nodiscard]] auto _check_size(std::uint32_t rule, node_tag tag,
+                                   std::size_t size,
+                                   const std::string& path) const
+        -> std::optional<schema_error>;
+
+   private:
+    std::vector<rule> _rules{};
+};
+
+// reader event handler checking a document against a schema as it is read,
+// the first violation is thrown as a `schema_violation_exception`; it runs
+// before the tree is built when `parse_options::schema` is set, and can be
+// given to `reader::feed` to check streamed documents without any tree
+class schema_checker final {
+   public:
+    explicit schema_checker(const schema& schema);
+
+    auto operator()(event_tag event, const reader& reader) -> void;
+    auto reset() noexcept -> void;
+
+   private:
+    struct frame {
+        bool isObject;
+        // range of `_rules` applying to the container
+        std::size_t rulesBegin;
+        std::size_t rulesEnd;
+        std::size_t pathSize;
+        std::size_t count;
+        // range of `_seen`, one flag per required key of every rule
+        std::size_t seenBegin;
+    };
+
+    auto _value(event_tag event, const reader& reader) -> void;
+    auto _end_container() -> void;
+    auto _end_value(std::size_t rulesBegin, std::size_t pathSize) -> void;
+    auto _throw_if(std::optional<schema_error>&& error) const -> void;
+
+   private:
+    const schema* _schema;
+    std::vector<std::uint32_t> _rules{};
+    std::vector<frame> _frames{};
+    std::vector<bool> _seen{};
+    std::string _path{};
+    std::string _key{};
+    // values some rules need whole, see `schema::rule::needsValue`
+    node_builder _builder{};
+    bool _building{false};
+    std::size_t _buildingRules{0};
+    std::size_t _buildingPath{0};
+};
+}  // namespace json
@@ -0,0 +1,155 @@
+#include "serializer.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <string_view>
+
+#include "simd.hpp"
+
+namespace json {
+auto write_string(std::string& out, std::string_view value) -> void {
+    constexpr std::string_view hex{"0123456789abcdef"};
+
+    out += '"';
+    while (!value.empty()) {
+        const auto run{find_escape(value)};
+        out.append(value.data(), run);
+        if (run == value.size()) break;
+
+        switch (const auto ch = value[run]) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                out += "\\u00";
+                out += hex[ch >> 4];
+                out += hex[ch & 0xF];
+        }
+        value.remove_prefix(run + 1);
+    }
+    out += '"';
+}
+
+template <std::floating_point Tp>
+auto write_floating(std::string& out, Tp value) -> void {
+    if (!std::isfinite(value))
+        throw node_exception("cannot serialize non-finite float value");
+
+    char buf[32];
+    const auto res{std::to_chars(buf, buf + sizeof(buf), value)};
+    out.append(buf, res.ptr);
+    // keep the value a float when it is parsed back
+    if (std::string_view{buf, res.ptr}.find_first_of(".e") ==
+        std::string_view::npos)
+        out += ".0";
+}
+
+auto write_float(std::string& out, float value) -> void {
+    write_floating(out, value);
+}
+
+auto write_float(std::string& out, double value) -> void {
+    write_floating(out, value);
+}
+
+auto write_newline(std::string& out, const serialize_options& options,
+                   uint depth) -> void {
+    if (options.indent == 0) return;
+    out += '\n';
+    out.append(options.indent * depth, ' ');
+}
+
+auto write_node(std::string& out, const node& value,
+                const serialize_options& options, uint depth) -> void {
+    char buf[32];
+    switch (value.tag()) {
+        case node_tag::JsonNull:
+            out += "null";
+            break;
+
+        case node_tag::JsonBool:
+            out += value.value<bool>() ? "true" : "false";
+            break;
+
+        case node_tag::JsonInt:
+        case node_tag::JsonFloat: {
+            if (const auto raw = value.get_if<raw_number>()) {
+                out += raw->lexeme;
+            } else if (const auto real = value.get_if<double>()) {
+                write_float(out, *real);
+            } else if (const auto integer = value.get_if<std::int64_t>()) {
+                const auto res{std::to_chars(buf, buf + sizeof(buf), *integer)};
+                out.append(buf, res.ptr);
+            } else {
+                const auto res{std::to_chars(buf, buf + sizeof(buf),
+                                             value.value<std::uint64_t>())};
+                out.append(buf, res.ptr);
+            }
+            break;
+        }
+
+        case node_tag::JsonString:
+            write_string(out, value.string());
+            break;
+
+        case node_tag::JsonArray: {
+            const auto& items{value.items()};
+            out += '[';
+            for (auto it{items.begin()}; it != items.end(); it++) {
+                if (it != items.begin()) out += ',';
+                write_newline(out, options, depth + 1);
+                write_node(out, *it, options, depth + 1);
+            }
+            if (!items.empty()) write_newline(out, options, depth);
+            out += ']';
+            break;
+        }
+
+        case node_tag::JsonObject: {
+            const auto& fields{value.fields()};
+            out += '{';
+            for (auto it{fields.begin()}; it != fields.end(); it++) {
+                if (it != fields.begin()) out += ',';
+                write_newline(out, options, depth + 1);
+                write_string(out, it->first);
+                out += options.indent == 0 ? ":" : ": ";
+                write_node(out, it->second, options, depth + 1);
+            }
+            if (!fields.empty()) write_newline(out, options, depth);
+            out += '}';
+            break;
+        }
+    }
+}
+
+auto serialize(const node& root, const serialize_options& options)
+    -> std::string {
+    std::string retval{};
+    serialize(root, retval, options);
+    return retval;
+}
+
+auto serialize(const node& root, std::string& buffer,
+               const serialize_options& options) -> void {
+    write_node(buffer, root, options, 0);
+}
+}  // namespace json
@@ -0,0 +1,38 @@
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "json.hpp"
+
+namespace json {
+struct serialize_options {
+    // spaces per nesting level, the output is compact when zero
+    uint indent{0};
+};
+
+[[nodiscard]]
+auto serialize(const node& root, const serialize_options& options = {})
+    -> std::string;
+// appends to `buffer`, which can be cleared and reused between calls
+auto serialize(const node& root, std::string& buffer,
+               const serialize_options& options = {}) -> void;
+
+// building blocks shared with the struct bindings
+auto write_string(std::string& out, std::string_view value) -> void;
+// shortest digits that parse back to the same value
+auto write_float(std::string& out, float value) -> void;
+auto write_float(std::string& out, double value) -> void;
+auto write_newline(std::string& out, const serialize_options& options,
+                   uint depth) -> void;
+
+template <std::output_iterator<char> OutputIt>
+auto serialize(const node& root, OutputIt out,
+               const serialize_options& options = {}) -> OutputIt {
+    thread_local std::string buffer{};
+    buffer.clear();
+    serialize(root, buffer, options);
+    return std::copy(buffer.begin(), buffer.end(), out);
+}
+}  // namespace json
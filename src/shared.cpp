@@ -0,0 +1,267 @@
+#include "shared.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+namespace json {
+struct shared_node::shared_array {
+    std::vector<shared_node> items{};
+};
+
+// insertion ordered entries, larger objects also keep their entry indices
+// sorted by key for binary searches
+struct shared_node::shared_object {
+    std::vector<entry> entries{};
+    std::vector<std::uint32_t> sorted{};
+
+    [[nodiscard]] auto find(std::string_view key) const noexcept
+        -> std::size_t {
+        if (entries.size() <= object::linear_scan_limit) {
+            for (std::size_t idx{0}; idx < entries.size(); idx++)
+                if (entries[idx].first == key) return idx;
+            return entries.size();
+        }
+
+        const auto it{_lower_bound(key)};
+        return it != sorted.end() && entries[*it].first == key
+                   ? *it
+                   : entries.size();
+    }
+
+    auto append(std::string_view key, shared_node&& value) -> shared_node& {
+        entries.emplace_back(std::string{key}, std::move(value));
+        if (entries.size() > object::linear_scan_limit) {
+            if (sorted.empty())
+                index();
+            else
+                sorted.insert(_lower_bound(key),
+                              static_cast<std::uint32_t>(entries.size() - 1));
+        }
+        return entries.back().second;
+    }
+
+    auto erase(std::size_t idx) -> void {
+        entries.erase(entries.begin() + idx);
+        sorted.clear();
+        if (entries.size() > object::linear_scan_limit) index();
+    }
+
+    auto index() -> void {
+        sorted.resize(entries.size());
+        for (std::size_t idx{0}; idx < sorted.size(); idx++)
+            sorted[idx] = static_cast<std::uint32_t>(idx);
+        std::sort(sorted.begin(), sorted.end(), [&](auto lhs, auto rhs) {
+            return entries[lhs].first < entries[rhs].first;
+        });
+    }
+
+   private:
+    [[nodiscard]] auto _lower_bound(std::string_view key) const noexcept
+        -> std::vector<std::uint32_t>::const_iterator {
+        return std::lower_bound(
+            sorted.begin(), sorted.end(), key,
+            [&](auto idx, auto key) { return entries[idx].first < key; });
+    }
+};
+
+/* shared_node implementation */
+shared_node::shared_node(const node& value) : _tag(value.tag()) {
+    switch (_tag) {
+        case node_tag::JsonNull:
+            break;
+
+        case node_tag::JsonString:
+            // borrowed strings would not outlive their source
+            _storage = std::make_shared<node>(std::string{value.string()});
+            break;
+
+        case node_tag::JsonArray: {
+            auto storage{std::make_shared<shared_array>()};
+            storage->items.reserve(value.items().size());
+            for (const auto& item : value.items())
+                storage->items.emplace_back(item);
+            _storage = std::move(storage);
+            break;
+        }
+
+        case node_tag::JsonObject: {
+            auto storage{std::make_shared<shared_object>()};
+            storage->entries.reserve(value.fields().size());
+            for (const auto& [key, field] : value.fields())
+                storage->entries.emplace_back(std::string{key.view()},
+                                              shared_node{field});
+            if (storage->entries.size() > object::linear_scan_limit)
+                storage->index();
+            _storage = std::move(storage);
+            break;
+        }
+
+        default:
+            _storage = std::make_shared<node>(value);
+            break;
+    }
+}
+
+auto shared_node::tag() const noexcept -> node_tag {
+    return _tag;
+}
+
+auto shared_node::size() const -> std::size_t {
+    switch (_tag) {
+        case node_tag::JsonArray:
+            return _array().items.size();
+        case node_tag::JsonObject:
+            return _object().entries.size();
+        default:
+            throw node_exception("cannot get the size of non-container nodes");
+    }
+}
+
+auto shared_node::string() const -> std::string_view {
+    return _scalar().string();
+}
+
+auto shared_node::items() const -> std::span<const shared_node> {
+    return _array().items;
+}
+
+auto shared_node::fields() const -> std::span<const entry> {
+    return _object().entries;
+}
+
+auto shared_node::at(uint idx) const -> const shared_node& {
+    const auto& items{_array().items};
+    if (idx >= items.size())
+        throw std::out_of_range(
+            std::format("index out of range: node field size {} ({} was given)",
+                        items.size(), idx));
+
+    return items[idx];
+}
+
+auto shared_node::field(std::string_view key) const -> const shared_node& {
+    const auto& value{_object()};
+    const auto idx{value.find(key)};
+    if (idx == value.entries.size())
+        throw std::out_of_range(std::format("key `{}` not in dictionary", key));
+
+    return value.entries[idx].second;
+}
+
+auto shared_node::contains(std::string_view key) const -> bool {
+    const auto& value{_object()};
+    return value.find(key) != value.entries.size();
+}
+
+auto shared_node::at(uint idx) -> shared_node& {
+    // checked before detaching, so a failed access copies nothing
+    static_cast<void>(std::as_const(*this).at(idx));
+    return _array_mut().items[idx];
+}
+
+auto shared_node::field(std::string_view key) -> shared_node& {
+    const auto idx{_object().find(key)};
+    if (idx == _object().entries.size())
+        throw std::out_of_range(std::format("key `{}` not in dictionary", key));
+
+    return _object_mut().entries[idx].second;
+}
+
+auto shared_node::operator[](std::string_view key) -> shared_node& {
+    auto& value{_object_mut()};
+    if (const auto idx = value.find(key); idx != value.entries.size())
+        return value.entries[idx].second;
+
+    return value.append(key, shared_node{});
+}
+
+auto shared_node::push_back(shared_node value) -> void {
+    _array_mut().items.push_back(std::move(value));
+}
+
+auto shared_node::erase(std::string_view key) -> bool {
+    const auto idx{_object().find(key)};
+    if (idx == _object().entries.size()) return false;
+
+    _object_mut().erase(idx);
+    return true;
+}
+
+auto shared_node::shares(const shared_node& other) const noexcept -> bool {
+    return _storage && _storage == other._storage;
+}
+
+auto shared_node::to_node() const -> node {
+    switch (_tag) {
+        case node_tag::JsonArray: {
+            array retval{};
+            retval.reserve(_array().items.size());
+            for (const auto& item : _array().items)
+                retval.push_back(item.to_node());
+            return node{std::move(retval)};
+        }
+
+        case node_tag::JsonObject: {
+            object retval{};
+            retval.reserve(_object().entries.size());
+            for (const auto& [key, field] : _object().entries)
+                retval.emplace(key, field.to_node());
+            return node{std::move(retval)};
+        }
+
+        default:
+            return _scalar();
+    }
+}
+
+auto shared_node::_scalar() const -> const node& {
+    static const node null{};
+    if (_tag == node_tag::JsonNull) return null;
+
+    if (_tag == node_tag::JsonArray || _tag == node_tag::JsonObject)
+        throw node_exception("cannot read the value of container nodes");
+
+    return *static_cast<const node*>(_storage.get());
+}
+
+auto shared_node::_array() const -> const shared_array& {
+    if (_tag != node_tag::JsonArray)
+        throw node_exception("cannot access non-array nodes items");
+
+    return *static_cast<const shared_array*>(_storage.get());
+}
+
+auto shared_node::_object() const -> const shared_object& {
+    if (_tag != node_tag::JsonObject)
+        throw node_exception("cannot access non-object nodes fields");
+
+    return *static_cast<const shared_object*>(_storage.get());
+}
+
+// copying a container only copies the handles of its children; `use_count`
+// is a relaxed load, the fence orders the reads of threads which dropped
+// their copy before the writes made in place
+auto shared_node::_array_mut() -> shared_array& {
+    const auto& value{_array()};
+    if (_storage.use_count() > 1)
+        _storage = std::make_shared<shared_array>(value);
+    else
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+    return *static_cast<shared_array*>(_storage.get());
+}
+
+auto shared_node::_object_mut() -> shared_object& {
+    const auto& value{_object()};
+    if (_storage.use_count() > 1)
+        _storage = std::make_shared<shared_object>(value);
+    else
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+    return *static_cast<shared_object*>(_storage.get());
+}
+}  // namespace json
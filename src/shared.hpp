@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "json.hpp"
+
+namespace json {
+// persistent tree: containers and values are reference counted and
+// immutable once shared, so copies are constant time; the non-const
+// accessors copy the containers on the path to the edited value when
+// they are shared (path copying) and edit them in place otherwise.
+// copies can be read and edited from different threads, a single handle
+// cannot
+class shared_node final {
+   public:
+    using entry = std::pair<std::string, shared_node>;
+
+    shared_node() noexcept = default;
+    // copies the tree once, borrowed strings included
+    shared_node(const node& value);
+    template <class Tp>
+        requires is_node_convertible<std::remove_cvref_t<Tp>>
+    shared_node(Tp&& value) : shared_node(node{std::forward<Tp>(value)}) {}
+
+    [[nodiscard]] auto tag() const noexcept -> node_tag;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    template <is_node_convertible Tp>
+    [[nodiscard]] auto value() const -> Tp {
+        return _scalar().value<Tp>();
+    }
+    [[nodiscard]] auto string() const -> std::string_view;
+
+    [[nodiscard]] auto items() const -> std::span<const shared_node>;
+    // in insertion order
+    [[nodiscard]] auto fields() const -> std::span<const entry>;
+
+    auto at(uint idx) const -> const shared_node&;
+    auto field(std::string_view key) const -> const shared_node&;
+    [[nodiscard]] auto contains(std::string_view key) const -> bool;
+
+    // detach the containers they go through, the returned reference is
+    // invalidated by the next structural change of its parent
+    auto at(uint idx) -> shared_node&;
+    auto field(std::string_view key) -> shared_node&;
+    // inserts a null value for missing keys
+    auto operator[](std::string_view key) -> shared_node&;
+    auto push_back(shared_node value) -> void;
+    auto erase(std::string_view key) -> bool;
+
+    // whether both handles refer to the same storage
+    [[nodiscard]] auto shares(const shared_node& other) const noexcept
+        -> bool;
+    // copies the value and everything below it into a tree
+    [[nodiscard]] auto to_node() const -> node;
+
+   private:
+    struct shared_array;
+    struct shared_object;
+
+    [[nodiscard]] auto _scalar() const -> const node&;
+    [[nodiscard]] auto _array() const -> const shared_array&;
+    [[nodiscard]] auto _object() const -> const shared_object&;
+    // copy on write, the storage is cloned unless this handle owns it alone
+    [[nodiscard]] auto _array_mut() -> shared_array&;
+    [[nodiscard]] auto _object_mut() -> shared_object&;
+
+   private:
+    node_tag _tag{node_tag::JsonNull};
+    // a node for scalars, empty for null
+    std::shared_ptr<void> _storage{};
+};
+}  // namespace json
@@ -0,0 +1,254 @@
+#include "simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define JSON_SIMD_X86
+#endif
+
+namespace json {
+struct block_masks {
+    std::uint64_t quote;
+    std::uint64_t backslash;
+    std::uint64_t whitespace;
+    std::uint64_t op;
+};
+
+auto classify_scalar(const char* block) noexcept -> block_masks {
+    block_masks retval{};
+    for (auto i{0}; i < 64; i++) {
+        const auto bit{std::uint64_t{1} << i};
+        switch (block[i]) {
+            case '"':
+                retval.quote |= bit;
+                break;
+            case '\\':
+                retval.backslash |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                retval.whitespace |= bit;
+                break;
+            case '[':
+            case ']':
+            case '{':
+            case '}':
+            case ':':
+            case ',':
+                retval.op |= bit;
+                break;
+        }
+    }
+    return retval;
+}
+
+#ifdef JSON_SIMD_X86
+auto classify_sse2(const char* block) noexcept -> block_masks {
+    const auto eq = [](__m128i chunk, char ch) {
+        return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(ch));
+    };
+
+    block_masks retval{};
+    for (auto i{0}; i < 4; i++) {
+        const auto chunk{_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(block + i * 16))};
+        const auto shift{i * 16};
+
+        const auto whitespace{
+            _mm_or_si128(_mm_or_si128(eq(chunk, ' '), eq(chunk, '\t')),
+                         _mm_or_si128(eq(chunk, '\n'), eq(chunk, '\r')))};
+        const auto op{_mm_or_si128(
+            _mm_or_si128(_mm_or_si128(eq(chunk, '['), eq(chunk, ']')),
+                         _mm_or_si128(eq(chunk, '{'), eq(chunk, '}'))),
+            _mm_or_si128(eq(chunk, ':'), eq(chunk, ',')))};
+
+        const auto mask = [](__m128i value) {
+            return static_cast<std::uint64_t>(
+                static_cast<std::uint16_t>(_mm_movemask_epi8(value)));
+        };
+
+        retval.quote |= mask(eq(chunk, '"')) << shift;
+        retval.backslash |= mask(eq(chunk, '\\')) << shift;
+        retval.whitespace |= mask(whitespace) << shift;
+        retval.op |= mask(op) << shift;
+    }
+    return retval;
+}
+
+__attribute__((target("avx2"))) inline auto eq_avx2(__m256i chunk,
+                                                   char ch) noexcept -> __m256i {
+    return _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(ch));
+}
+
+__attribute__((target("avx2"))) inline auto mask_avx2(__m256i value) noexcept
+    -> std::uint64_t {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(value));
+}
+
+__attribute__((target("avx2"))) auto classify_avx2(const char* block) noexcept
+    -> block_masks {
+    block_masks retval{};
+    for (auto i{0}; i < 2; i++) {
+        const auto chunk{_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(block + i * 32))};
+        const auto shift{i * 32};
+
+        const auto whitespace{
+            _mm256_or_si256(_mm256_or_si256(eq_avx2(chunk, ' '),
+                                            eq_avx2(chunk, '\t')),
+                            _mm256_or_si256(eq_avx2(chunk, '\n'),
+                                            eq_avx2(chunk, '\r')))};
+        const auto op{_mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_or_si256(eq_avx2(chunk, '['), eq_avx2(chunk, ']')),
+                _mm256_or_si256(eq_avx2(chunk, '{'), eq_avx2(chunk, '}'))),
+            _mm256_or_si256(eq_avx2(chunk, ':'), eq_avx2(chunk, ',')))};
+
+        retval.quote |= mask_avx2(eq_avx2(chunk, '"')) << shift;
+        retval.backslash |= mask_avx2(eq_avx2(chunk, '\\')) << shift;
+        retval.whitespace |= mask_avx2(whitespace) << shift;
+        retval.op |= mask_avx2(op) << shift;
+    }
+    return retval;
+}
+#endif
+
+using classify_fn = auto (*)(const char*) noexcept -> block_masks;
+
+auto select_classifier() noexcept -> classify_fn {
+#ifdef JSON_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return classify_avx2;
+    return classify_sse2;
+#else
+    return classify_scalar;
+#endif
+}
+
+auto prefix_xor(std::uint64_t bits) noexcept -> std::uint64_t {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+auto build_structural_index(std::string_view source,
+                            std::vector<std::uint32_t>& index) -> bool {
+    static const auto classify{select_classifier()};
+    if (source.size() > std::numeric_limits<std::uint32_t>::max()) {
+        index.clear();
+        return false;
+    }
+
+    // positions are written through a raw pointer, the vector only grows
+    std::size_t count{0};
+    index.resize(std::max<std::size_t>(index.capacity(), 64));
+
+    // state carried from one block to the next
+    std::uint64_t escapedCarry{0};
+    std::uint64_t inStringCarry{0};
+    std::uint64_t boundaryCarry{1};
+
+    char padded[64];
+    for (std::size_t offset{0}; offset < source.size(); offset += 64) {
+        const char* block{source.data() + offset};
+        const auto length{source.size() - offset};
+        if (length < 64) {
+            std::memset(padded, ' ', sizeof(padded));
+            std::memcpy(padded, block, length);
+            block = padded;
+        }
+
+        const auto masks{classify(block)};
+
+        // a backslash escapes the next byte unless it is escaped itself
+        auto escaped{escapedCarry};
+        auto backslash{masks.backslash & ~escapedCarry};
+        escapedCarry = 0;
+        while (backslash) {
+            const auto bit{backslash & -backslash};
+            if (bit >> 63) escapedCarry = 1;
+            escaped |= bit << 1;
+            backslash &= ~(bit | bit << 1);
+        }
+
+        const auto quote{masks.quote & ~escaped};
+        const auto inString{prefix_xor(quote) ^ inStringCarry};
+        inStringCarry = static_cast<std::uint64_t>(
+            -static_cast<std::int64_t>(inString >> 63));
+
+        const auto boundary{masks.whitespace | (masks.op & ~inString) |
+                            (quote & ~inString)};
+        const auto scalar{~(masks.whitespace | masks.op | quote) & ~inString &
+                          (boundary << 1 | boundaryCarry)};
+        boundaryCarry = boundary >> 63;
+
+        auto structural{(masks.op & ~inString) | (quote & inString) | scalar};
+        if (length < 64) structural &= (std::uint64_t{1} << length) - 1;
+
+        if (count + 64 > index.size()) index.resize(index.size() * 2);
+
+        auto out{index.data() + count};
+        count += std::popcount(structural);
+        while (structural) {
+            *out++ = static_cast<std::uint32_t>(offset +
+                                                std::countr_zero(structural));
+            structural &= structural - 1;
+        }
+    }
+
+    index.resize(count);
+    return true;
+}
+
+auto find_escape(std::string_view value) noexcept -> std::size_t {
+    std::size_t idx{0};
+#ifdef JSON_SIMD_X86
+    const auto quote{_mm_set1_epi8('"')};
+    const auto backslash{_mm_set1_epi8('\\')};
+    const auto control{_mm_set1_epi8(0x1F)};
+    for (; idx + 16 <= value.size(); idx += 16) {
+        const auto chunk{_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(value.data() + idx))};
+        const auto special{_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                         _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control))};
+
+        if (const auto mask = _mm_movemask_epi8(special); mask != 0)
+            return idx + std::countr_zero(static_cast<unsigned>(mask));
+    }
+#endif
+
+    for (; idx < value.size(); idx++) {
+        const auto ch{static_cast<unsigned char>(value[idx])};
+        if (ch == '"' || ch == '\\' || ch < 0x20) return idx;
+    }
+    return value.size();
+}
+
+auto find_non_ascii(std::string_view value) noexcept -> std::size_t {
+    std::size_t idx{0};
+#ifdef JSON_SIMD_X86
+    for (; idx + 16 <= value.size(); idx += 16) {
+        const auto chunk{_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(value.data() + idx))};
+        if (const auto mask = _mm_movemask_epi8(chunk); mask != 0)
+            return idx + std::countr_zero(static_cast<unsigned>(mask));
+    }
+#endif
+
+    for (; idx < value.size(); idx++)
+        if (static_cast<unsigned char>(value[idx]) >= 0x80) return idx;
+    return value.size();
+}
+}  // namespace json
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace json {
+// positions of every token start outside of strings: brackets, braces,
+// colons, commas, opening quotes and the first byte of other scalars;
+// blocks of 64 bytes are classified with avx2 or sse2 when the cpu allows it,
+// returns false for sources whose positions do not fit the index
+auto build_structural_index(std::string_view source,
+                            std::vector<std::uint32_t>& index) -> bool;
+
+// index of the first byte that must be escaped inside a json string
+// (quote, backslash or control character), `value.size()` if there is none
+[[nodiscard]]
+auto find_escape(std::string_view value) noexcept -> std::size_t;
+
+// index of the first byte outside of ascii, `value.size()` if there is none
+[[nodiscard]]
+auto find_non_ascii(std::string_view value) noexcept -> std::size_t;
+}  // namespace json
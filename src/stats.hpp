@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#include "json.hpp"
+
+namespace json {
+// counters added to by `deserialize` and `deserialize_file` when
+// `parse_options::stats` is set; they are only recorded when the library is
+// built with JSON_PARSE_STATS defined, e.g.
+// `CXXFLAGS=-DJSON_PARSE_STATS ./build.sh`, otherwise the recording code is
+// compiled out and the counters are left untouched
+struct parse_stats {
+    std::size_t bytes{0};
+    // indexed by `node_tag`
+    std::array<std::size_t, 7> nodes{};
+    std::size_t max_depth{0};
+    // buffers requested while building the tree: container growth and key
+    // indices are observed, while strings, keys too long for the small
+    // string buffer and new interned keys are predicted from their lengths
+    std::size_t allocations{0};
+    std::size_t allocated_bytes{0};
+    // tokenizing and number conversion are sampled around every event, so
+    // their sum with `build_time` is slower than an unmeasured parse
+    std::chrono::nanoseconds index_time{};
+    std::chrono::nanoseconds scan_time{};
+    std::chrono::nanoseconds number_time{};
+    std::chrono::nanoseconds build_time{};
+
+    [[nodiscard]] auto count(node_tag tag) const noexcept -> std::size_t {
+        return nodes[static_cast<std::size_t>(tag)];
+    }
+};
+}  // namespace json
@@ -0,0 +1,38 @@
+#include "symbols.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace json {
+auto symbol_table::intern(std::string_view name) -> symbol {
+    const auto hash{std::hash<std::string_view>{}(name)};
+    if (const auto it = _names.find(name); it != _names.end())
+        return {*it, hash};
+
+    // empty names still get an address of their own
+    const auto data{static_cast<char*>(
+        _storage.allocate(std::max<std::size_t>(name.size(), 1), 1))};
+    std::memcpy(data, name.data(), name.size());
+
+    const std::string_view stored{data, name.size()};
+    _names.insert(stored);
+    return {stored, hash};
+}
+
+auto symbol_table::find(std::string_view name) const noexcept -> symbol {
+    const auto it{_names.find(name)};
+    if (it == _names.end()) return {};
+
+    return {*it, std::hash<std::string_view>{}(name)};
+}
+
+auto symbol_table::size() const noexcept -> std::size_t {
+    return _names.size();
+}
+
+auto symbol_table::clear() noexcept -> void {
+    _names.clear();
+    _storage.reset();
+}
+}  // namespace json
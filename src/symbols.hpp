@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <unordered_set>
+
+#include "arena.hpp"
+#include "json.hpp"
+
+namespace json {
+// object keys stored once, shared by every tree parsed with the table; it
+// must outlive those trees, which compare keys by address through `symbol`
+class symbol_table final {
+   public:
+    symbol_table() = default;
+    symbol_table(const symbol_table&) = delete;
+    auto operator=(const symbol_table&) -> symbol_table& = delete;
+
+    auto intern(std::string_view name) -> symbol;
+    // a symbol without name when `name` was never interned
+    [[nodiscard]] auto find(std::string_view name) const noexcept -> symbol;
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+    // invalidates every tree built with the table
+    auto clear() noexcept -> void;
+
+   private:
+    arena _storage{4 * 1024};
+    std::unordered_set<std::string_view> _names{};
+};
+}  // namespace json
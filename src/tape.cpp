@@ -0,0 +1,283 @@
+#include "tape.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "reader.hpp"
+#include "simd.hpp"
+
+namespace json {
+constexpr std::uint64_t payloadMask{(std::uint64_t{1} << 56) - 1};
+constexpr std::uint64_t indexMask{0xFFFFFFFF};
+constexpr std::uint64_t countLimit{0xFFFFFF};
+
+/* tape_cursor implementation */
+tape_cursor::tape_cursor(const tape* tape, std::size_t idx) noexcept
+    : _tape(tape), _idx(idx) {}
+
+auto tape_cursor::tag() const -> node_tag {
+    switch (_tape->_type(_idx)) {
+        case 't':
+        case 'f':
+            return node_tag::JsonBool;
+        case 'l':
+        case 'u':
+            return node_tag::JsonInt;
+        case 'd':
+            return node_tag::JsonFloat;
+        case '"':
+            return node_tag::JsonString;
+        case '[':
+            return node_tag::JsonArray;
+        case '{':
+            return node_tag::JsonObject;
+        default:
+            return node_tag::JsonNull;
+    }
+}
+
+auto tape_cursor::size() const -> std::size_t {
+    const auto type{_tape->_type(_idx)};
+    if (type != '[' && type != '{')
+        throw node_exception("cannot get the size of non-container nodes");
+
+    const auto count{_tape->_payload(_idx) >> 32};
+    if (count < countLimit) return count;
+
+    // the count saturates, very large containers are walked instead
+    std::size_t retval{0};
+    for (auto idx{_idx + 1}; _tape->_type(idx) != ']' && _tape->_type(idx) != '}';
+         idx = _tape->_next(type == '{' ? idx + 1 : idx))
+        retval++;
+
+    return retval;
+}
+
+auto tape_cursor::at(uint idx) const -> tape_cursor {
+    if (_tape->_type(_idx) != '[')
+        throw node_exception("cannot access non-array nodes items");
+
+    if (const auto count = size(); idx >= count)
+        throw std::out_of_range(std::format(
+            "index out of range: node field size {} ({} was given)", count,
+            idx));
+
+    auto item{_idx + 1};
+    for (uint i{0}; i < idx; i++) item = _tape->_next(item);
+    return {_tape, item};
+}
+
+auto tape_cursor::field(std::string_view key) const -> tape_cursor {
+    if (_tape->_type(_idx) != '{')
+        throw node_exception("cannot access non-object nodes fields");
+
+    for (auto idx{_idx + 1}; _tape->_type(idx) != '}';
+         idx = _tape->_next(idx + 1)) {
+        if (tape_cursor{_tape, idx}._as_string() == key)
+            return {_tape, idx + 1};
+    }
+
+    throw std::out_of_range(std::format("key `{}` not in dictionary", key));
+}
+
+auto tape_cursor::_expect(char type) const -> void {
+    if (_tape->_type(_idx) != type)
+        throw node_exception("cannot read value: tape entry holds another type");
+}
+
+auto tape_cursor::_as_bool() const -> bool {
+    if (_tape->_type(_idx) == 'f') return false;
+    _expect('t');
+    return true;
+}
+
+auto tape_cursor::_as_int() const -> std::int64_t {
+    _expect('l');
+    return std::bit_cast<std::int64_t>(_tape->_entries[_idx + 1]);
+}
+
+auto tape_cursor::_as_uint() const -> std::uint64_t {
+    _expect('u');
+    return _tape->_entries[_idx + 1];
+}
+
+auto tape_cursor::_as_small_int() const -> int {
+    if (_tape->_type(_idx) == 'u') {
+        if (const auto value = _as_uint(); std::in_range<int>(value))
+            return static_cast<int>(value);
+    } else if (const auto value = _as_int(); std::in_range<int>(value)) {
+        return static_cast<int>(value);
+    }
+    throw node_exception("cannot read value: number out of range");
+}
+
+auto tape_cursor::_as_float() const -> double {
+    // integers are read as doubles too, like in `node::value`
+    switch (_tape->_type(_idx)) {
+        case 'l':
+            return static_cast<double>(_as_int());
+        case 'u':
+            return static_cast<double>(_as_uint());
+        default:
+            _expect('d');
+            return std::bit_cast<double>(_tape->_entries[_idx + 1]);
+    }
+}
+
+auto tape_cursor::_as_string() const -> std::string_view {
+    _expect('"');
+    const auto offset{_tape->_payload(_idx)};
+    std::uint32_t length{};
+    std::memcpy(&length, _tape->_strings.data() + offset, sizeof(length));
+    return {_tape->_strings.data() + offset + sizeof(length), length};
+}
+
+/* tape implementation */
+auto tape::root() const -> tape_cursor {
+    if (_entries.empty()) throw node_exception("cannot access an empty tape");
+    return {this, 0};
+}
+
+auto tape::entries() const noexcept -> std::size_t {
+    return _entries.size();
+}
+
+auto tape::_type(std::size_t idx) const noexcept -> char {
+    return static_cast<char>(_entries[idx] >> 56);
+}
+
+auto tape::_payload(std::size_t idx) const noexcept -> std::uint64_t {
+    return _entries[idx] & payloadMask;
+}
+
+auto tape::_next(std::size_t idx) const noexcept -> std::size_t {
+    switch (_type(idx)) {
+        case '[':
+        case '{':
+            return _payload(idx) & indexMask;
+        case 'l':
+        case 'u':
+        case 'd':
+            return idx + 2;
+        default:
+            return idx + 1;
+    }
+}
+
+auto tape::_append(char type, std::uint64_t payload) -> std::size_t {
+    _entries.push_back(static_cast<std::uint64_t>(type) << 56 | payload);
+    return _entries.size() - 1;
+}
+
+auto tape::_append_string(std::string_view value) -> void {
+    _append('"', _strings.size());
+
+    if (value.size() > std::numeric_limits<std::uint32_t>::max())
+        throw invalid_json_exception(std::format(
+            "string of {} bytes is too long for a tape", value.size()));
+    const auto length{static_cast<std::uint32_t>(value.size())};
+    _strings.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    _strings.append(value);
+}
+
+auto deserialize_tape(std::string_view content) -> tape {
+    struct scope {
+        std::size_t open;
+        std::uint64_t count;
+    };
+
+    tape retval{};
+    std::vector<scope> stack{};
+    const auto counted = [&] {
+        if (!stack.empty()) stack.back().count++;
+    };
+
+    std::vector<std::uint32_t> index{};
+    auto reader{build_structural_index(content, index)
+                    ? json::reader{content, index}
+                    : json::reader{content}};
+    while (true) {
+        switch (const auto event = reader.next()) {
+            case event_tag::JsonNull:
+                retval._append('n', 0);
+                counted();
+                break;
+
+            case event_tag::JsonBool:
+                retval._append(reader.boolean() ? 't' : 'f', 0);
+                counted();
+                break;
+
+            case event_tag::JsonNumber:
+                if (reader.out_of_range() &&
+                    std::isinf(std::get<double>(reader.number())))
+                    throw_number_overflow(reader.string(), reader.position());
+                if (const auto number = reader.number();
+                    const auto value = std::get_if<std::int64_t>(&number)) {
+                    retval._append('l', 0);
+                    retval._entries.push_back(
+                        std::bit_cast<std::uint64_t>(*value));
+                } else if (const auto value =
+                               std::get_if<std::uint64_t>(&number)) {
+                    retval._append('u', 0);
+                    retval._entries.push_back(*value);
+                } else {
+                    retval._append('d', 0);
+                    retval._entries.push_back(
+                        std::bit_cast<std::uint64_t>(std::get<double>(number)));
+                }
+                counted();
+                break;
+
+            case event_tag::JsonString:
+                retval._append_string(reader.string());
+                counted();
+                break;
+
+            case event_tag::ObjectKey:
+                retval._append_string(reader.string());
+                break;
+
+            case event_tag::ArrayStart:
+            case event_tag::ObjectStart:
+                stack.push_back(
+                    {retval._append(event == event_tag::ArrayStart ? '[' : '{',
+                                    0),
+                     0});
+                break;
+
+            case event_tag::ArrayEnd:
+            case event_tag::ObjectEnd: {
+                const auto [open, count] = stack.back();
+                stack.pop_back();
+
+                const auto close{retval._append(
+                    event == event_tag::ArrayEnd ? ']' : '}', open)};
+                // the index past the close entry shares the word with the
+                // count, larger documents do not fit a tape
+                if (close + 1 > indexMask)
+                    throw invalid_json_exception(std::format(
+                        "document too large for a tape: more than {} entries",
+                        indexMask));
+                retval._entries[open] |=
+                    std::min(count, countLimit) << 32 | (close + 1);
+                counted();
+                break;
+            }
+
+            case event_tag::DocumentEnd:
+                return retval;
+
+            case event_tag::NeedInput:
+                throw std::logic_error(
+                    "unreachable: complete documents never need more input");
+        }
+    }
+}
+}  // namespace json
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "json.hpp"
+
+namespace json {
+class tape;
+
+// read-only view of a single value stored in a tape
+class tape_cursor final {
+   public:
+    [[nodiscard]] auto tag() const -> node_tag;
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    template <class Tp>
+    [[nodiscard]] auto value() const -> Tp {
+        if constexpr (std::is_same_v<void*, Tp>) {
+            _expect('n');
+            return nullptr;
+        } else if constexpr (std::is_same_v<bool, Tp>) {
+            return _as_bool();
+        } else if constexpr (std::is_same_v<std::int64_t, Tp>) {
+            return _as_int();
+        } else if constexpr (std::is_same_v<std::uint64_t, Tp>) {
+            return _as_uint();
+        } else if constexpr (std::is_same_v<int, Tp>) {
+            return _as_small_int();
+        } else if constexpr (std::is_floating_point_v<Tp>) {
+            return static_cast<Tp>(_as_float());
+        } else if constexpr (std::is_same_v<std::string_view, Tp>) {
+            return _as_string();
+        } else if constexpr (std::is_same_v<std::string, Tp>) {
+            return Tp{_as_string()};
+        } else {
+            static_assert(!sizeof(Tp), "unsupported tape value type");
+        }
+    }
+
+    [[nodiscard]] auto at(uint idx) const -> tape_cursor;
+    [[nodiscard]] auto field(std::string_view key) const -> tape_cursor;
+
+   private:
+    friend class tape;
+    tape_cursor(const tape* tape, std::size_t idx) noexcept;
+
+    auto _expect(char type) const -> void;
+    auto _as_bool() const -> bool;
+    auto _as_int() const -> std::int64_t;
+    auto _as_uint() const -> std::uint64_t;
+    // range checked, like `node::value<int>`
+    auto _as_small_int() const -> int;
+    auto _as_float() const -> double;
+    auto _as_string() const -> std::string_view;
+
+   private:
+    const tape* _tape;
+    std::size_t _idx;
+};
+
+// flat document: every value is one tagged 64 bits entry (numbers take a
+// second one for their payload), containers store the index past their
+// matching close entry and strings are offsets into a side buffer
+class tape final {
+   public:
+    tape() noexcept = default;
+
+    [[nodiscard]] auto root() const -> tape_cursor;
+    [[nodiscard]] auto entries() const noexcept -> std::size_t;
+
+   private:
+    friend class tape_cursor;
+    friend auto deserialize_tape(std::string_view content) -> tape;
+
+    [[nodiscard]] auto _type(std::size_t idx) const noexcept -> char;
+    [[nodiscard]] auto _payload(std::size_t idx) const noexcept
+        -> std::uint64_t;
+    [[nodiscard]] auto _next(std::size_t idx) const noexcept -> std::size_t;
+
+    auto _append(char type, std::uint64_t payload) -> std::size_t;
+    auto _append_string(std::string_view value) -> void;
+
+   private:
+    std::vector<std::uint64_t> _entries{};
+    std::string _strings{};
+};
+
+[[nodiscard]]
+auto deserialize_tape(std::string_view content) -> tape;
+}  // namespace json
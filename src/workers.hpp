@@ -0,0 +1,43 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace json {
+// hands out batches of `batchSize` tasks to `worker(begin, end, thread)` on a
+// pool of threads and rethrows the first failure once every thread is done,
+// one thread per hardware thread when `threads` is zero
+template <class Worker>
+auto run_workers(std::size_t count, uint threads, std::size_t batchSize,
+                 Worker&& worker) -> void {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<std::size_t>(threads, (count + batchSize - 1) / batchSize);
+
+    std::atomic<std::size_t> next{0};
+    std::vector<std::exception_ptr> errors(threads);
+    const auto loop = [&](uint thread) {
+        try {
+            for (auto begin{next.fetch_add(batchSize)}; begin < count;
+                 begin = next.fetch_add(batchSize))
+                worker(begin, std::min(begin + batchSize, count), thread);
+        } catch (...) {
+            errors[thread] = std::current_exception();
+            next = count;
+        }
+    };
+
+    if (threads > 0) {
+        // the calling thread takes its share of the batches too
+        std::vector<std::jthread> pool{};
+        for (uint thread{1}; thread < threads; thread++)
+            pool.emplace_back(loop, thread);
+        loop(0);
+    }
+
+    for (const auto& error : errors)
+        if (error) std::rethrow_exception(error);
+}
+}  // namespace json